@@ -0,0 +1,178 @@
+/**************************************************************************************************
+ *
+ * \file acq.c
+ *
+ * \brief Block-based ADC acquisition implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/acq.h"
+
+#include "inc/lib/debug.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(CLA_OFFLOAD)
+#include "app/acq_cla.h"
+
+/** Written by the CLA only, the CPU has read access                                              */
+#pragma DATA_SECTION(acq_cla_state, "Cla1ToCpuMsgRAM")
+struct acq_state acq_cla_state;
+#endif
+
+/**************************************************************************************************
+ *
+ * acq_new()
+ *
+ *************************************************************************************************/
+struct acq *
+acq_new(void)
+{
+    static struct acq acq;
+    memset(&acq, 0u, sizeof(struct acq));
+
+    static struct acq_state state;
+    memset(&state, 0u, sizeof(struct acq_state));
+
+    acq.state = &state;
+
+    return &acq;
+}
+
+/**************************************************************************************************
+ *
+ * acq_notify()
+ *
+ *************************************************************************************************/
+void
+acq_notify(struct acq *self, struct task_evt *evt)
+{
+    if (self) {
+        self->evt = evt;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * acq_row()
+ *
+ *************************************************************************************************/
+__attribute__((ramfunc)) uint16_t *
+acq_row(struct acq *self)
+{
+    return self->block[self->fill].raw[self->index];
+}
+
+/**************************************************************************************************
+ *
+ * acq_push()
+ *
+ *************************************************************************************************/
+__attribute__((ramfunc)) void
+acq_push(struct acq *self)
+{
+    if (!self) {
+        return;
+    }
+
+    if (++self->index >= ACQ_BLOCK) {
+        (void) acq_commit(self);
+    }
+}
+
+/**************************************************************************************************
+ *
+ * acq_commit()
+ *
+ *************************************************************************************************/
+__attribute__((ramfunc)) uint16_t *
+acq_commit(struct acq *self)
+{
+    uint16_t half = self->fill;
+
+    self->index = 0U;
+    self->ready |= (1U << half);
+
+    /* Background is late, the oldest block is dropped and refilled */
+    half ^= 1U;
+    if (self->ready & (1U << half)) {
+        self->ready &= ~(1U << half);
+        self->overrun++;
+    }
+    self->fill = half;
+
+    task_evt_set(self->evt, TASK_EVT_ACQ);
+
+    return self->block[half].raw[0];
+}
+
+#if defined(CLA_OFFLOAD)
+/**************************************************************************************************
+ *
+ * acq_cla()
+ *
+ *************************************************************************************************/
+void
+acq_cla(struct acq *self)
+{
+    ASSERT(self);
+
+    self->state = &acq_cla_state;
+    self->blocks = acq_cla_state.blocks;
+    self->cla = true;
+}
+#endif
+
+/**************************************************************************************************
+ *
+ * acq_run()
+ *
+ *************************************************************************************************/
+int
+acq_run(struct acq *self)
+{
+    ASSERT(self);
+
+    if (self->cla) {
+        uint32_t blocks = self->state->blocks;
+        int n = (blocks != self->blocks) ? 1 : 0;
+
+        self->blocks = blocks;
+        return n;
+    }
+
+    /* Only the half not being filled can be complete */
+    uint16_t half = self->fill ^ 1U;
+    uint16_t mask = 1U << half;
+
+    if (!(self->ready & mask)) {
+        return 0;
+    }
+
+    acq_kernel(&self->block[half], self->state);
+
+    self->ready &= ~mask;
+    self->blocks++;
+
+    return 1;
+}
+
+/**************************************************************************************************
+ *
+ * acq_get()
+ *
+ *************************************************************************************************/
+int
+acq_get(const struct acq *self, enum acq_ch ch, float *value)
+{
+    if (!self || !value || ch >= ACQ_CH_N || !self->state->valid) {
+        return -1;
+    }
+
+    *value = self->state->value[ch];
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**************************************************************************************************
+ *
+ * \file acq.h
+ *
+ * \brief Block-based ADC acquisition interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_ACQ_H
+#define _APP_ACQ_H
+
+#include "app/task_evt.h"
+#include "app/acq_kernel.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Ping-pong acquisition buffer. The producer (DMA, or the ADC interrupt when DMA is not
+ * available) fills one half while the background job processes the other one. The buffer has no
+ * hardware dependencies, so the producer and consumer logic also runs on the host.
+ *
+ *************************************************************************************************/
+struct acq {
+    struct acq_block block[2];
+    volatile uint16_t fill;         /* Half being filled, owned by the producer                 */
+    volatile uint16_t index;        /* Next sample in the half being filled                     */
+    volatile uint16_t ready;        /* Halves waiting to be processed (bit per half)            */
+    volatile uint32_t overrun;      /* Blocks overwritten before they were processed            */
+    uint32_t blocks;                /* Blocks seen by acq_run() since start-up                  */
+    bool dma;                       /* True if blocks are filled by DMA                         */
+    bool cla;                       /* True if the CLA acquires and filters the blocks          */
+    struct acq_state *state;        /* Filter state and results                                 */
+    struct task_evt *evt;           /* Raises TASK_EVT_ACQ on every completed block, if set     */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new acquisition object
+ *
+ * \param None
+ *
+ * \return Acquisition object handler
+ *
+ *************************************************************************************************/
+extern struct acq *
+acq_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Sets events object that is told about every completed block
+ *
+ * \param self acquisition object handler
+ * \param evt task activation events object handler
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+acq_notify(struct acq *self, struct task_evt *evt);
+
+/**************************************************************************************************
+ *
+ * \brief Returns row the next sample goes to. Used by the per-sample producer only.
+ *
+ * \param self acquisition object handler
+ *
+ * \return Row of ACQ_CH_N raw results
+ *
+ *************************************************************************************************/
+extern uint16_t *
+acq_row(struct acq *self);
+
+/**************************************************************************************************
+ *
+ * \brief Advances to the next row once the ADC interrupt has written the current one. When the
+ * half is full it is committed with acq_commit().
+ *
+ * \param self acquisition object handler; nothing happens if NULL
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+acq_push(struct acq *self);
+
+/**************************************************************************************************
+ *
+ * \brief Marks the half being filled as complete, swaps halves and raises TASK_EVT_ACQ. If the
+ * other half was not processed yet, it is dropped and counted as overrun. Called by the DMA
+ * interrupt at every half-buffer boundary.
+ *
+ * \param self acquisition object handler
+ *
+ * \return First row of the half to be filled next
+ *
+ *************************************************************************************************/
+extern uint16_t *
+acq_commit(struct acq *self);
+
+#if defined(CLA_OFFLOAD)
+/**************************************************************************************************
+ *
+ * \brief Hands acquisition over to the CLA. Results are then read from CLA-to-CPU message RAM
+ * and the ping-pong buffer is no longer used. Call once the CLA tasks are running.
+ *
+ * \param self acquisition object handler
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+acq_cla(struct acq *self);
+#endif
+
+/**************************************************************************************************
+ *
+ * \brief Filters the completed block and converts it to physical units. Must only be called
+ * from the background job. When the CLA does the filtering, only picks up its results.
+ *
+ * \param self acquisition object handler
+ *
+ * \return Number of blocks processed (0 or 1)
+ *
+ *************************************************************************************************/
+extern int
+acq_run(struct acq *self);
+
+/**************************************************************************************************
+ *
+ * \brief Reads physical value of a channel
+ *
+ * \param self acquisition object handler
+ * \param ch channel
+ * \param value Pointer to value buffer (V)
+ *
+ * \return 0 if operation is successful; -1 if no block was processed yet
+ *
+ *************************************************************************************************/
+extern int
+acq_get(const struct acq *self, enum acq_ch ch, float *value);
+
+#endif /* _APP_ACQ_H */
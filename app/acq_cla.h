@@ -0,0 +1,36 @@
+/**************************************************************************************************
+ *
+ * \file acq_cla.h
+ *
+ * \brief ADC acquisition on the CLA (CLA_OFFLOAD), data shared between the CPU and the CLA
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_ACQ_CLA_H
+#define _APP_ACQ_CLA_H
+
+#include "app/acq_kernel.h"
+
+/** Filter state and results, in CLA-to-CPU message RAM                                          */
+extern struct acq_state acq_cla_state;
+
+/**************************************************************************************************
+ *
+ * \brief CLA task 1, triggered by ADCINT2 once per sample. Stores the sample and runs
+ * acq_kernel() on every completed block.
+ *
+ *************************************************************************************************/
+extern __interrupt void
+Cla1Task1(void);
+
+/**************************************************************************************************
+ *
+ * \brief CLA task 8, forced once at start-up. Clears the message RAM the CPU cannot write.
+ *
+ *************************************************************************************************/
+extern __interrupt void
+Cla1Task8(void);
+
+#endif /* _APP_ACQ_CLA_H */
@@ -0,0 +1,108 @@
+/**************************************************************************************************
+ *
+ * \file acq_kernel.h
+ *
+ * \brief ADC block filter kernel. Plain C with fixed-width types only, so the same code is built
+ * for the C28x, for the CLA (CLA_OFFLOAD) and for the host.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_ACQ_KERNEL_H
+#define _APP_ACQ_KERNEL_H
+
+#include <stdint.h>
+
+/** Samples per channel in one block. One block is 6.4 ms at C_ISR_FREQ.                         */
+#define ACQ_BLOCK           (16U)
+
+/** ADC conversion, same as ADC_SET_CONV() in hapi_rev0.c                                       */
+#define ACQ_ADC_RESOLUTION  (4096U)
+#define ACQ_ADC_VREF        (3.3f)
+
+/** Coefficient of the first-order filter applied to block means                                 */
+#define ACQ_FILTER_ALPHA    (0.25f)
+
+/**************************************************************************************************
+ *
+ * Acquired ADC channels, same order as the ADC object in app/adc.h. These are the only SOCs set
+ * up on this board revision, the button inputs. The analog channels of app/wcs.h have no SOC
+ * yet (wcs_new() is stubbed out); they are added here once they are wired.
+ *
+ *************************************************************************************************/
+enum acq_ch {
+    ACQ_BUTTON0,
+    ACQ_BUTTON1,
+    ACQ_BUTTON2,
+    ACQ_BUTTON3,
+    ACQ_BUTTON_CW,
+    ACQ_CH_N
+};
+
+/**************************************************************************************************
+ *
+ * Block of raw results, sample-major so the ISR writes one contiguous row per sample
+ *
+ *************************************************************************************************/
+struct acq_block {
+    uint16_t raw[ACQ_BLOCK][ACQ_CH_N];
+};
+
+/**************************************************************************************************
+ *
+ * Filter state and results. With CLA_OFFLOAD it sits in CLA-to-CPU message RAM, so the layout
+ * must be the same for both cores (no pointers, no bool).
+ *
+ *************************************************************************************************/
+struct acq_state {
+    float filt[ACQ_CH_N];           /* Filtered block means (ADC counts)                        */
+    float value[ACQ_CH_N];          /* Physical values (V)                                      */
+    uint32_t blocks;                /* Blocks processed since start-up                          */
+    uint16_t valid;                 /* Zero until the first block is processed                  */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Averages a block, runs the first-order filter on the block means and converts them to
+ * physical units
+ *
+ * \param block raw results
+ * \param state filter state and results
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+static inline void
+acq_kernel(const struct acq_block *block, struct acq_state *state)
+{
+    uint32_t sum[ACQ_CH_N];
+    uint16_t i, ch;
+
+    for (ch = 0U; ch < ACQ_CH_N; ch++) {
+        sum[ch] = 0UL;
+    }
+
+    for (i = 0U; i < ACQ_BLOCK; i++) {
+        for (ch = 0U; ch < ACQ_CH_N; ch++) {
+            sum[ch] += block->raw[i][ch];
+        }
+    }
+
+    for (ch = 0U; ch < ACQ_CH_N; ch++) {
+        float mean = (float) sum[ch] * (1.0f / (float) ACQ_BLOCK);
+
+        if (state->valid) {
+            state->filt[ch] += ACQ_FILTER_ALPHA * (mean - state->filt[ch]);
+        } else {
+            state->filt[ch] = mean;
+        }
+
+        state->value[ch] = state->filt[ch] * (ACQ_ADC_VREF / (float) ACQ_ADC_RESOLUTION);
+    }
+
+    state->valid = 1U;
+    state->blocks++;
+}
+
+#endif /* _APP_ACQ_KERNEL_H */
@@ -0,0 +1,143 @@
+/**************************************************************************************************
+ *
+ * \file atlas.c
+ *
+ * \brief Pre-packed icon and glyph atlas implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/atlas.h"
+
+#include "app/screen.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * atlas_font_find()
+ *
+ *************************************************************************************************/
+const struct atlas_font *
+atlas_font_find(const char *name)
+{
+    unsigned i;
+
+    if (!name) {
+        return NULL;
+    }
+
+    for (i = 0U; i < atlas_font_size; i++) {
+        if (strcmp(atlas_font[i].name, name) == 0) {
+            return &atlas_font[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**************************************************************************************************
+ *
+ * atlas_draw()
+ *
+ *************************************************************************************************/
+void
+atlas_draw(uint8_t *buf, int16_t x, int16_t y, const struct atlas_bitmap *bmp, bool blend)
+{
+    if (!buf || !bmp) {
+        return;
+    }
+
+    /* Clip to screen, on the left in whole bytes of the source rows */
+    int16_t skip = 0;
+    if (x < 0) {
+        skip = (int16_t) ((1 - x) / 2);
+        x += 2 * skip;
+    }
+
+    int16_t width = (int16_t) bmp->width - 2 * skip;
+    if (x + width > (int16_t) SCREEN_WIDTH) {
+        width = (int16_t) SCREEN_WIDTH - x;
+    }
+    if (width <= 0) {
+        return;
+    }
+
+    /* Source and destination bytes per row, an odd x shifts every pixel by one nibble */
+    bool odd = (x & 1) != 0;
+    uint16_t n = (uint16_t) (width + 1) / 2U;
+    uint16_t m = (uint16_t) (width + (odd ? 2 : 1)) / 2U;
+
+    /* Nibbles of the first and last destination bytes that belong to the bitmap */
+    uint16_t first = odd ? 0x0FU : 0xFFU;
+    uint16_t last = ((width + (odd ? 1 : 0)) & 1) ? 0xF0U : 0xFFU;
+
+    int16_t row;
+    for (row = 0; row < (int16_t) bmp->height; row++) {
+        int16_t line = y + row;
+        if (line < 0 || line >= (int16_t) SCREEN_HEIGHT) {
+            continue;
+        }
+
+        const uint8_t *src = &atlas_data[bmp->offset + (uint32_t) row * bmp->stride + skip];
+        uint8_t *dst = &buf[(uint16_t) line * SCREEN_ROW_BYTES + (uint16_t) x / 2U];
+
+        /* Fast path: whole bytes of an even row copied as they are */
+        if (!odd && !blend && last == 0xFFU) {
+            memcpy(dst, src, n);
+            continue;
+        }
+
+        uint16_t i;
+        for (i = 0U; i < m; i++) {
+            uint16_t v;
+            uint16_t mask = 0xFFU;
+
+            if (odd) {
+                v = ((i > 0U) ? (uint16_t) (src[i - 1U] << 4) : 0U) | ((i < n) ? src[i] >> 4 : 0U);
+            } else {
+                v = src[i];
+            }
+
+            if (i == 0U) {
+                mask &= first;
+            }
+            if (i == m - 1U) {
+                mask &= last;
+            }
+
+            v &= mask;
+            dst[i] = (blend ? (dst[i] | v) : ((dst[i] & ~mask) | v)) & 0xFFU;
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * atlas_text()
+ *
+ *************************************************************************************************/
+int16_t
+atlas_text(uint8_t *buf, int16_t x, int16_t y, const struct atlas_font *font, const char *str)
+{
+    if (!font || !str) {
+        return x;
+    }
+
+    for (; *str; str++) {
+        uint16_t c = (uint16_t) *str & 0xFFU;
+
+        if (c < font->first || c > font->last) {
+            continue;
+        }
+
+        const struct atlas_glyph *glyph = &font->glyph[c - font->first];
+
+        atlas_draw(buf, x + glyph->x_offset, y + glyph->y_offset, &glyph->bitmap, true);
+        x += glyph->x_advance;
+    }
+
+    return x;
+}
@@ -0,0 +1,137 @@
+/**************************************************************************************************
+ *
+ * \file atlas.h
+ *
+ * \brief Pre-packed icon and glyph atlas interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_ATLAS_H
+#define _APP_ATLAS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Icons registered in CMakeLists.txt. Names must match the icon names passed to the atlas
+ * generator (tools/atlas_gen.py).
+ *
+ *************************************************************************************************/
+enum atlas_icon {
+    ATLAS_ICON_ABOUT,
+    ATLAS_ICON_FAULT,
+    ATLAS_ICON_SUPERSET,
+    ATLAS_ICON_MODULE,
+    ATLAS_ICON_NONE,
+    ATLAS_ICON_SET,
+    ATLAS_ICON_STACK,
+    ATLAS_ICON_VERSION,
+    ATLAS_ICON_BOOST,
+    ATLAS_ICON_BUCK,
+    ATLAS_ICON_INVERTER,
+    ATLAS_ICON_NEUTRAL,
+    ATLAS_ICON_PWM,
+    ATLAS_ICON_RECTIFIER,
+    ATLAS_ICON_3_PH_GEN_1,
+    ATLAS_ICON_END
+};
+
+/**************************************************************************************************
+ *
+ * Bitmap in SSD1322 native format: 4 bits per pixel, left pixel in the high nibble, rows padded to
+ * whole display RAM columns
+ *
+ *************************************************************************************************/
+struct atlas_bitmap {
+    uint16_t width;                 /* Width (pixels)                                           */
+    uint16_t height;                /* Height (pixels)                                          */
+    uint16_t stride;                /* Bytes per row                                            */
+    uint32_t offset;                /* First byte in atlas_data[]                               */
+};
+
+/**************************************************************************************************
+ *
+ * Font glyph, placement as in Adafruit GFX fonts
+ *
+ *************************************************************************************************/
+struct atlas_glyph {
+    struct atlas_bitmap bitmap;
+    int16_t x_advance;              /* Cursor advance (pixels)                                  */
+    int16_t x_offset;               /* Bitmap offset from cursor (pixels)                       */
+    int16_t y_offset;               /* Bitmap offset from baseline (pixels)                     */
+};
+
+/**************************************************************************************************
+ *
+ * Font
+ *
+ *************************************************************************************************/
+struct atlas_font {
+    const char *name;               /* GFX font name, e.g. "FreeMono9pt7b"                      */
+    uint16_t first;                 /* First character                                          */
+    uint16_t last;                  /* Last character                                           */
+    uint16_t y_advance;             /* Line height (pixels)                                     */
+    const struct atlas_glyph *glyph;
+};
+
+/**************************************************************************************************
+ *
+ * Atlas generated at build time
+ *
+ *************************************************************************************************/
+extern const uint8_t atlas_data[];
+extern const struct atlas_bitmap atlas_icon[ATLAS_ICON_END];
+extern const struct atlas_font atlas_font[];
+extern const unsigned atlas_font_size;
+
+/**************************************************************************************************
+ *
+ * \brief Looks up font by its GFX name. Meant to be called once at start-up.
+ *
+ * \param name font name
+ *
+ * \return Font if found; NULL otherwise
+ *
+ *************************************************************************************************/
+extern const struct atlas_font *
+atlas_font_find(const char *name);
+
+/**************************************************************************************************
+ *
+ * \brief Draws bitmap into a frame buffer (SCREEN_BUF_SIZE bytes). Rows starting at an even x are
+ * copied as they are; an odd x costs one nibble shift per byte. Parts outside the screen are
+ * clipped.
+ *
+ * \param buf frame buffer
+ * \param x left edge (pixels)
+ * \param y top edge (pixels)
+ * \param bmp bitmap
+ * \param blend true to OR the bitmap onto the frame; false to overwrite it
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+atlas_draw(uint8_t *buf, int16_t x, int16_t y, const struct atlas_bitmap *bmp, bool blend);
+
+/**************************************************************************************************
+ *
+ * \brief Draws text into a frame buffer. Glyphs are blended, so overlapping glyph boxes do not
+ * erase each other; the area should be cleared beforehand.
+ *
+ * \param buf frame buffer
+ * \param x cursor (pixels)
+ * \param y baseline (pixels)
+ * \param font font
+ * \param str text; characters outside the font are skipped
+ *
+ * \return Cursor after the last character
+ *
+ *************************************************************************************************/
+extern int16_t
+atlas_text(uint8_t *buf, int16_t x, int16_t y, const struct atlas_font *font, const char *str);
+
+#endif /* _APP_ATLAS_H */
@@ -0,0 +1,173 @@
+/**************************************************************************************************
+ *
+ * \file can_filter.c
+ *
+ * \brief CAN acceptance filter manager implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/can_filter.h"
+
+#include "app/tlo.h"
+#include "app/hapi.h"
+#include "app/dev_ctl.h"
+
+#include "inc/lib/debug.h"
+#include "inc/lib/nfo.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * \brief Identifier of the frames a module sends and receives, device type and stack position
+ *
+ *************************************************************************************************/
+static uint32_t
+can_filter_key(uint16_t id, uint16_t stack)
+{
+    return (((uint32_t) stack << 24) | ((uint32_t) (id & 0xFFU) << 16)) & CAN_FILTER_MASK_DEV;
+}
+
+/**************************************************************************************************
+ *
+ * \brief Adds a module to the filter: only the bits it agrees on with all others stay masked
+ *
+ *************************************************************************************************/
+static void
+can_filter_span(struct can_filter *self, uint32_t key)
+{
+    self->mask &= ~(key ^ self->id);
+    self->id &= self->mask;
+}
+
+/**************************************************************************************************
+ *
+ * can_filter_reserve()
+ *
+ *************************************************************************************************/
+uint16_t
+can_filter_reserve(uint32_t valid)
+{
+    uint16_t n = 0U;
+
+    /* Objects below the lowest valid one, lowest first */
+    while (n < CAN_FILTER_OBJS && n < HAPI_CAN_OBJECTS && !(valid & (1UL << n))) {
+        n++;
+    }
+
+    return n;
+}
+
+/**************************************************************************************************
+ *
+ * can_filter_new()
+ *
+ *************************************************************************************************/
+struct can_filter *
+can_filter_new(const struct tlo *tlo)
+{
+    if (!(tlo)) {
+        return NULL;
+    }
+
+    static struct can_filter can_filter;
+    memset(&can_filter, 0u, sizeof(struct can_filter));
+
+    can_filter.fw_objs = hapi_can_objects();
+    can_filter.n = can_filter_reserve(can_filter.fw_objs);
+
+    /* One FIFO for the device type broadcasts from every module on the bus */
+    uint16_t i;
+    for (i = 0U; i < can_filter.n; i++) {
+        if (hapi_can_filter(i + 1U, CAN_FILTER_ID_DEV_TYPE, CAN_FILTER_MASK_MSG,
+                i + 1U == can_filter.n) < 0) {
+            return NULL;
+        }
+    }
+
+    /* Only fw_lib's catch-all receive objects are narrowed, its other objects are left alone */
+    for (i = 0U; i < HAPI_CAN_OBJECTS; i++) {
+        uint32_t id, mask;
+        if ((can_filter.fw_objs & (1UL << i)) && hapi_can_accept_get(i + 1U, &id, &mask) == 0 &&
+                mask == 0UL) {
+            can_filter.fw_rx |= 1UL << i;
+        }
+    }
+    can_filter.wide = true;
+
+    return &can_filter;
+}
+
+/**************************************************************************************************
+ *
+ * can_filter_update()
+ *
+ *************************************************************************************************/
+int
+can_filter_update(struct can_filter *self, const struct tlo *tlo)
+{
+    if (!self || !tlo || !tlo->dev_ctl) {
+        return -1;
+    }
+
+    const struct dev_ctl *dev_ctl = tlo->dev_ctl;
+    bool wide = dev_ctl_sniffing(tlo);
+
+    if (wide == self->wide && (wide || dev_ctl->generation == self->generation)) {
+        return 0;
+    }
+
+    uint32_t id = self->id;
+    uint32_t mask = self->mask;
+
+    self->wide = wide;
+    self->generation = dev_ctl->generation;
+
+    if (wide) {
+        self->id = 0UL;
+        self->mask = 0UL;
+    } else {
+        /* The module itself: own database, boot loader and data loggers */
+        self->id = can_filter_key(tlo->mod->id, tlo->mod->address);
+        self->mask = CAN_FILTER_MASK_DEV;
+        if (tlo->boot) {
+            can_filter_span(self, can_filter_key(tlo->boot->id, tlo->boot->address));
+        }
+        #ifdef DLOG
+        can_filter_span(self, can_filter_key(NFO_DLOG, tlo->mod->address));
+        #endif
+        #ifdef LOGGING
+        can_filter_span(self, can_filter_key(NFO_LOGGING, tlo->mod->address));
+        #endif
+
+        /* Devices the remote databases talk to */
+        uint16_t i;
+        for (i = 0U; i < N_DEVICES; i++) {
+            const struct can_dev *can_dev = &dev_ctl->can_dev[i];
+            if (can_dev->present) {
+                can_filter_span(self, can_filter_key(can_dev->id, can_dev->stack));
+            }
+        }
+    }
+
+    if (self->id == id && self->mask == mask) {
+        return 0;
+    }
+
+    int n = 0;
+    uint16_t i;
+    for (i = 0U; i < HAPI_CAN_OBJECTS; i++) {
+        if (self->fw_rx & (1UL << i)) {
+            if (hapi_can_accept_set(i + 1U, self->id, self->mask) < 0) {
+                return -1;
+            }
+            n++;
+        }
+    }
+    self->updates++;
+
+    return n;
+}
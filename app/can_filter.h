@@ -0,0 +1,107 @@
+/**************************************************************************************************
+ *
+ * \file can_filter.h
+ *
+ * \brief CAN acceptance filter manager interface. Reserves receive message objects for the
+ * application and points them at the device type broadcasts, which only concern the device
+ * registry. Everything else stays with the message objects fw_lib's init() sets up, because the
+ * databases only decode frames read through db_run().
+ *
+ * Reserved range: message objects 1 to CAN_FILTER_OBJS, cut short at the first object init()
+ * left valid. The controller stores a frame in the lowest-numbered object that accepts it, so
+ * only objects below fw_lib's own take frames away from it. If fw_lib starts at object 1 nothing
+ * is reserved and the broadcasts reach the registry through the database exception filter, as
+ * all other frames do.
+ *
+ * fw_lib's receive objects accept every frame (CAN mask 0) while the user interface lists the
+ * devices on the bus. Otherwise they are narrowed to the module itself and the devices present
+ * in the registry: one identifier and mask that every one of them matches, covering stack
+ * position and device type. Frames of other devices are then dropped by the controller.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_CAN_FILTER_H
+#define _APP_CAN_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Forward declarations
+ *
+ *************************************************************************************************/
+
+struct tlo;
+
+/** Most receive message objects reserved, chained as a FIFO for broadcast bursts               */
+#define CAN_FILTER_OBJS         (4U)
+
+/**************************************************************************************************
+ *
+ * CAN identifier layout: [31:24] stack position, [23:16] device type, [15:0] message ID
+ *
+ *************************************************************************************************/
+#define CAN_FILTER_MASK_MSG     (0x0000FFFFUL)
+#define CAN_FILTER_MASK_DEV     (0x1FFF0000UL)  /* Stack position and device type              */
+#define CAN_FILTER_ID_DEV_TYPE  (0x00008000UL)  /* Device type broadcast message ID             */
+
+/**************************************************************************************************
+ *
+ * CAN filter manager object definition
+ *
+ *************************************************************************************************/
+struct can_filter {
+    uint32_t fw_objs;               /* Objects valid after init(), bit 0 for object 1           */
+    uint32_t fw_rx;                 /* fw_lib's receive objects that accept every frame         */
+    uint16_t n;                     /* Reserved message objects, from object 1; 0 if none free  */
+    bool wide;                      /* fw_rx objects accept every frame                         */
+    uint16_t generation;            /* Registry generation the filter was worked out for        */
+    uint32_t id;                    /* Filter of the fw_rx objects                              */
+    uint32_t mask;
+    uint32_t updates;               /* Times the fw_rx objects were reprogrammed                */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new CAN filter manager object. Must be called after init(), so that fw_lib's
+ * message objects are already set up, and before the CAN receive interrupt is enabled.
+ *
+ * \param tlo top-level object handler
+ *
+ * \return CAN filter manager object handler; NULL on hardware error
+ *
+ *************************************************************************************************/
+extern struct can_filter *
+can_filter_new(const struct tlo *tlo);
+
+/**************************************************************************************************
+ *
+ * \brief Works out the number of reserved message objects from the objects already in use
+ *
+ * \param valid message objects in use, bit 0 for object 1
+ *
+ * \return Number of reserved message objects from object 1, from 0 to CAN_FILTER_OBJS
+ *
+ *************************************************************************************************/
+extern uint16_t
+can_filter_reserve(uint32_t valid);
+
+/**************************************************************************************************
+ *
+ * \brief Brings the filter of fw_lib's receive objects up to date with the user interface state
+ * and the device registry. Does nothing unless either changed since the last call. Must be
+ * called with hapi_can_lock() held.
+ *
+ * \param self CAN filter manager object handler
+ * \param tlo top-level object handler
+ *
+ * \return Number of message objects reprogrammed; -1 on hardware error
+ *
+ *************************************************************************************************/
+extern int
+can_filter_update(struct can_filter *self, const struct tlo *tlo);
+
+#endif /* _APP_CAN_FILTER_H */
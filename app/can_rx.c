@@ -0,0 +1,124 @@
+/**************************************************************************************************
+ *
+ * \file can_rx.c
+ *
+ * \brief CAN receive ring buffer implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/can_rx.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define CAN_RX_MASK         (CAN_RX_SIZE - 1U)
+
+#if (CAN_RX_SIZE & CAN_RX_MASK) != 0U
+#error "CAN_RX_SIZE must be a power of two"
+#endif
+
+/**
+ * Frames are copied in and out through volatile pointers, so the compiler keeps those accesses
+ * in order with the volatile head and tail updates. Hosted builds (tests) also need a real
+ * barrier.
+ */
+#if defined(__TMS320C28XX__)
+#define CAN_RX_BARRIER()
+#else
+#define CAN_RX_BARRIER()    __sync_synchronize()
+#endif
+
+/**************************************************************************************************
+ *
+ * can_rx_new()
+ *
+ *************************************************************************************************/
+struct can_rx *
+can_rx_new(void)
+{
+    static struct can_rx can_rx;
+    memset(&can_rx, 0u, sizeof(struct can_rx));
+
+    return &can_rx;
+}
+
+/**************************************************************************************************
+ *
+ * can_rx_notify()
+ *
+ *************************************************************************************************/
+void
+can_rx_notify(struct can_rx *self, struct task_evt *evt)
+{
+    self->evt = evt;
+}
+
+/**************************************************************************************************
+ *
+ * can_rx_push()
+ *
+ *************************************************************************************************/
+__attribute__((ramfunc)) bool
+can_rx_push(struct can_rx *self, const struct can_f *f, uint32_t timestamp)
+{
+    uint16_t head = self->head;
+    uint16_t level = (uint16_t) ((head - self->tail) & 0xFFFFU);
+
+    if (level >= CAN_RX_SIZE) {
+        self->overflow++;
+        return false;
+    }
+
+    volatile struct can_rx_frame *frame = &self->buf[head & CAN_RX_MASK];
+    frame->f = *f;
+    frame->timestamp = timestamp;
+
+    /* Publish the frame only after it has been written completely */
+    CAN_RX_BARRIER();
+    self->head = (uint16_t) (head + 1U);
+
+    if (level + 1U > self->hwm) {
+        self->hwm = level + 1U;
+    }
+
+    task_evt_set(self->evt, TASK_EVT_CAN_RX);
+
+    return true;
+}
+
+/**************************************************************************************************
+ *
+ * can_rx_pop()
+ *
+ *************************************************************************************************/
+bool
+can_rx_pop(struct can_rx *self, struct can_rx_frame *frame)
+{
+    uint16_t tail = self->tail;
+
+    if (tail == self->head) {
+        return false;
+    }
+
+    CAN_RX_BARRIER();
+    *frame = *(volatile const struct can_rx_frame *) &self->buf[tail & CAN_RX_MASK];
+
+    /* Release the slot only after it has been copied out */
+    CAN_RX_BARRIER();
+    self->tail = (uint16_t) (tail + 1U);
+
+    return true;
+}
+
+/**************************************************************************************************
+ *
+ * can_rx_level()
+ *
+ *************************************************************************************************/
+uint16_t
+can_rx_level(const struct can_rx *self)
+{
+    return (uint16_t) ((self->head - self->tail) & 0xFFFFU);
+}
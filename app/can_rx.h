@@ -0,0 +1,112 @@
+/**************************************************************************************************
+ *
+ * \file can_rx.h
+ *
+ * \brief CAN receive ring buffer interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_CAN_RX_H
+#define _APP_CAN_RX_H
+
+#include "inc/net/can.h"
+
+#include "app/task_evt.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Ring buffer size in frames, must be a power of two                                           */
+#define CAN_RX_SIZE         (64U)
+
+/**************************************************************************************************
+ *
+ * Received frame with its receive timestamp
+ *
+ *************************************************************************************************/
+struct can_rx_frame {
+    struct can_f f;                 /* CAN frame                                                */
+    uint32_t timestamp;             /* Receive time (hapi_timestamp() ticks)                    */
+};
+
+/**************************************************************************************************
+ *
+ * Single-producer (receive interrupt) / single-consumer (CAN job) ring buffer
+ *
+ *************************************************************************************************/
+struct can_rx {
+    struct can_rx_frame buf[CAN_RX_SIZE];
+    volatile uint16_t head;         /* Next slot to write, owned by the producer                */
+    volatile uint16_t tail;         /* Next slot to read, owned by the consumer                 */
+    volatile uint16_t hwm;          /* Highest fill level seen since start-up                   */
+    volatile uint32_t overflow;     /* Frames dropped because the ring was full                 */
+    struct task_evt *evt;           /* Raises TASK_EVT_CAN_RX on every stored frame, if set     */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new CAN receive ring buffer object
+ *
+ * \param None
+ *
+ * \return CAN receive ring buffer object handler
+ *
+ *************************************************************************************************/
+extern struct can_rx *
+can_rx_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Sets events object that is told about every frame stored in the ring
+ *
+ * \param self CAN receive ring buffer object handler
+ * \param evt task activation events object handler
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+can_rx_notify(struct can_rx *self, struct task_evt *evt);
+
+/**************************************************************************************************
+ *
+ * \brief Pushes frame into the ring. Must only be called from the receive interrupt.
+ *
+ * \param self CAN receive ring buffer object handler
+ * \param f CAN frame
+ * \param timestamp receive time
+ *
+ * \return True if frame was stored; false if the ring was full and the frame was dropped
+ *
+ *************************************************************************************************/
+extern bool
+can_rx_push(struct can_rx *self, const struct can_f *f, uint32_t timestamp);
+
+/**************************************************************************************************
+ *
+ * \brief Pops oldest frame from the ring. Must only be called from the consumer.
+ *
+ * \param self CAN receive ring buffer object handler
+ * \param frame Pointer to frame buffer
+ *
+ * \return True if a frame was read; false if the ring is empty
+ *
+ *************************************************************************************************/
+extern bool
+can_rx_pop(struct can_rx *self, struct can_rx_frame *frame);
+
+/**************************************************************************************************
+ *
+ * \brief Returns number of frames waiting in the ring
+ *
+ * \param self CAN receive ring buffer object handler
+ *
+ * \return Fill level
+ *
+ *************************************************************************************************/
+extern uint16_t
+can_rx_level(const struct can_rx *self);
+
+#endif /* _APP_CAN_RX_H */
@@ -0,0 +1,212 @@
+/**************************************************************************************************
+ *
+ * \file can_tx.c
+ *
+ * \brief Outbound device command queue implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/can_tx.h"
+
+#include "app/tlo.h"
+
+#include "inc/api/db.h"
+#include "inc/lib/debug.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * \brief Resolves database used to talk to a device type
+ *
+ * \param tlo top-level object handler
+ * \param id device type
+ *
+ * \return Database object handler; NULL if device type is not supported
+ *
+ *************************************************************************************************/
+static const struct db *
+can_tx_db(const struct tlo *tlo, enum nfo_id id)
+{
+    switch (id) {
+    case NFO_BP25:
+        return (const struct db *) tlo->db_afe;
+    case NFO_VG11_FM01:
+        return (const struct db *) tlo->db_vg11_fm01;
+    case NFO_VG11_FM02:
+        return (const struct db *) tlo->db_vg11_fm02;
+    default:
+        return NULL;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * can_tx_new()
+ *
+ *************************************************************************************************/
+struct can_tx *
+can_tx_new(const struct tlo *tlo)
+{
+    if (!(tlo)) {
+        return NULL;
+    }
+
+    static struct can_tx can_tx;
+    memset(&can_tx, 0u, sizeof(struct can_tx));
+
+    return &can_tx;
+}
+
+/**************************************************************************************************
+ *
+ * can_tx_push()
+ *
+ *************************************************************************************************/
+int
+can_tx_push(struct can_tx *self, const struct dev_ctl *dev_ctl, uint16_t dev)
+{
+    ASSERT(self && dev_ctl);
+
+    if (dev >= N_DEVICES) {
+        return -1;
+    }
+
+    const struct can_dev *can_dev = &dev_ctl->can_dev[dev];
+
+    /* Coalesce with pending entry for the same device */
+    uint16_t i;
+    for (i = 0U; i < self->count; i++) {
+        struct can_tx_entry *entry = &self->queue[(self->head + i) % N_DEVICES];
+        if (entry->id == can_dev->id && entry->stack == can_dev->stack) {
+            entry->dev = dev;
+            return 0;
+        }
+    }
+
+    if (self->count >= N_DEVICES) {
+        return -1;
+    }
+
+    struct can_tx_entry *entry = &self->queue[(self->head + self->count) % N_DEVICES];
+    entry->id = can_dev->id;
+    entry->stack = can_dev->stack;
+    entry->dev = dev;
+    self->count++;
+
+    return 0;
+}
+
+/**************************************************************************************************
+ *
+ * can_tx_scan()
+ *
+ *************************************************************************************************/
+void
+can_tx_scan(struct can_tx *self, const struct dev_ctl *dev_ctl)
+{
+    ASSERT(self && dev_ctl);
+
+    uint16_t i;
+    for (i = 0U; i < N_DEVICES; i++) {
+        const struct can_dev *can_dev = &dev_ctl->can_dev[i];
+
+        /* Freed or registered to another device: start from the requests of a new slot */
+        if (!can_dev->present || !self->seen[i] || self->serial[i] != can_dev->serial_number) {
+            self->seen[i] = can_dev->present;
+            self->serial[i] = can_dev->serial_number;
+            self->last_on[i] = false;
+            self->last_mode[i] = 0;
+            self->last_clear[i] = false;
+        }
+
+        if (!can_dev->present || !can_dev->compatible) {
+            continue;
+        }
+
+        bool req = can_dev->setpoint_changed ||
+                   can_dev->request_on != self->last_on[i] ||
+                   can_dev->request_mode != self->last_mode[i] ||
+                   (can_dev->clear_interlock && !self->last_clear[i]);
+
+        self->last_on[i] = can_dev->request_on;
+        self->last_mode[i] = can_dev->request_mode;
+        self->last_clear[i] = can_dev->clear_interlock;
+
+        if (req) {
+            (void) can_tx_push(self, dev_ctl, i);
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * can_tx_begin()
+ *
+ *************************************************************************************************/
+int
+can_tx_begin(struct can_tx *self, const struct tlo *tlo)
+{
+    ASSERT(self && tlo);
+
+    struct dev_ctl *dev_ctl = tlo->dev_ctl;
+
+    while (self->count > 0U) {
+        struct can_tx_entry entry = self->queue[self->head];
+        self->head = (self->head + 1U) % N_DEVICES;
+        self->count--;
+
+        /* Device may have left or moved since the request was queued */
+        const struct can_dev *can_dev = &dev_ctl->can_dev[entry.dev];
+        if (!can_dev->present || can_dev->id != entry.id || can_dev->stack != entry.stack) {
+            continue;
+        }
+
+        const struct db *db = can_tx_db(tlo, entry.id);
+        if (!db) {
+            continue;
+        }
+
+        /* Database callbacks build the frames from the registry entry of this device */
+        db_subscribe(db, entry.id, entry.stack, DB_ID_DEV_ADR_M);
+        dev_ctl->send_message_to = ((uint16_t) entry.stack << 8) | ((uint16_t) entry.id & 0xFFU);
+
+        self->active = entry;
+        self->busy = true;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**************************************************************************************************
+ *
+ * can_tx_end()
+ *
+ *************************************************************************************************/
+void
+can_tx_end(struct can_tx *self, const struct tlo *tlo)
+{
+    ASSERT(self && tlo);
+
+    /**
+     * Device databases only receive from every device while unsubscribed. This also drops a
+     * subscription the user interface made to send a message.
+     */
+    db_unsubscribe((const struct db *) tlo->db_afe);
+    db_unsubscribe((const struct db *) tlo->db_vg11_fm01);
+    db_unsubscribe((const struct db *) tlo->db_vg11_fm02);
+
+    if (!self->busy) {
+        return;
+    }
+
+    /* Setpoints went out with this run */
+    tlo->dev_ctl->can_dev[self->active.dev].setpoint_changed = false;
+
+    self->busy = false;
+}
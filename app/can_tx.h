@@ -0,0 +1,129 @@
+/**************************************************************************************************
+ *
+ * \file can_tx.h
+ *
+ * \brief Outbound device command queue interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_CAN_TX_H
+#define _APP_CAN_TX_H
+
+#include "app/dev_ctl.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Forward declarations
+ *
+ *************************************************************************************************/
+
+struct tlo;
+
+/**************************************************************************************************
+ *
+ * Queue entry, keyed by (device type, stack)
+ *
+ *************************************************************************************************/
+struct can_tx_entry {
+    enum nfo_id id;                 /* Device type                                              */
+    uint8_t stack;                  /* Stack position                                           */
+    uint16_t dev;                   /* Device registry slot                                     */
+};
+
+/**************************************************************************************************
+ *
+ * Outbound command queue object definition
+ *
+ *************************************************************************************************/
+struct can_tx {
+    struct can_tx_entry queue[N_DEVICES];   /* FIFO of devices with pending requests            */
+    uint16_t head;                  /* Oldest entry                                             */
+    uint16_t count;                 /* Number of entries                                        */
+    struct can_tx_entry active;     /* Device served by the current database run                */
+    bool busy;                      /* Database subscribed to the active device                 */
+    bool seen[N_DEVICES];           /* Slot held a registered device on previous scan           */
+    uint32_t serial[N_DEVICES];     /* Serial number of that device                             */
+    bool last_on[N_DEVICES];        /* On/off request seen on previous scan                     */
+    int last_mode[N_DEVICES];       /* Mode request seen on previous scan                       */
+    bool last_clear[N_DEVICES];     /* Interlock clear request seen on previous scan            */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new outbound command queue object
+ *
+ * \param tlo top-level object handler
+ *
+ * \return Outbound command queue object handler
+ *
+ *************************************************************************************************/
+extern struct can_tx *
+can_tx_new(const struct tlo *tlo);
+
+/**************************************************************************************************
+ *
+ * \brief Queues device for transmission. A device that already has an entry in the queue keeps
+ * its position.
+ *
+ * \param self outbound command queue object handler
+ * \param dev_ctl device registry object handler
+ * \param dev device registry slot
+ *
+ * \return 0 if operation is successful; -1 otherwise
+ *
+ *************************************************************************************************/
+extern int
+can_tx_push(struct can_tx *self, const struct dev_ctl *dev_ctl, uint16_t dev);
+
+/**************************************************************************************************
+ *
+ * \brief Queues devices with a setpoint, on/off, mode or interlock clear request raised on the
+ * device registry (can_dev.setpoint_changed, request_on, request_mode and clear_interlock). The
+ * requests seen on a slot are forgotten when the slot is freed or registers another device.
+ *
+ * \param self outbound command queue object handler
+ * \param dev_ctl device registry object handler
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+can_tx_scan(struct can_tx *self, const struct dev_ctl *dev_ctl);
+
+/**************************************************************************************************
+ *
+ * \brief Prepares the next queued device for the database run of the CAN job: its database is
+ * subscribed to it and dev_ctl.send_message_to is set, so the database callbacks build the
+ * frames from its registry entry. One device is served per database run, as send_message_to
+ * names a single target; the CAN job runs the databases again until the queue is empty.
+ *
+ * \param self outbound command queue object handler
+ * \param tlo top-level object handler
+ *
+ * \return 1 if a device is served by the next run; 0 otherwise
+ *
+ *************************************************************************************************/
+extern int
+can_tx_begin(struct can_tx *self, const struct tlo *tlo);
+
+/**************************************************************************************************
+ *
+ * \brief Completes the device prepared by can_tx_begin() once the database run has transmitted.
+ * The device databases are unsubscribed after every run, served device or not, so they receive
+ * from all devices again.
+ *
+ * \param self outbound command queue object handler
+ * \param tlo top-level object handler
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+can_tx_end(struct can_tx *self, const struct tlo *tlo);
+
+#endif /* _APP_CAN_TX_H */
@@ -0,0 +1,198 @@
+/**************************************************************************************************
+ *
+ * \file cell.c
+ *
+ * \brief Formatted-value cell cache implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/cell.h"
+
+#include "app/dev_snap.h"
+#include "app/fmt.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/** Digits after the decimal point for units without an entry below                             */
+#define CELL_DECIMALS_DEFAULT   (2U)
+
+/**************************************************************************************************
+ *
+ * Display resolution per unit
+ *
+ *************************************************************************************************/
+struct cell_unit {
+    const char *unit;
+    uint16_t decimals;
+};
+
+static const struct cell_unit cell_unit[] = {
+    { "V",   1U },
+    { "A",   2U },
+    { "W",   0U },
+    { "kW",  2U },
+    { "VA",  0U },
+    { "kVA", 2U },
+    { "Hz",  2U },
+    { "%",   1U },
+    { "C",   1U },
+    { "rpm", 0U },
+    { "s",   1U },
+};
+
+#define CELL_UNIT_N     (sizeof(cell_unit) / sizeof(cell_unit[0]))
+
+/**************************************************************************************************
+ *
+ * \brief Looks up digits after the decimal point for a unit. A leading degree sign is ignored.
+ *
+ *************************************************************************************************/
+static uint16_t
+cell_decimals(const char *unit)
+{
+    uint16_t i;
+
+    if (!unit) {
+        return CELL_DECIMALS_DEFAULT;
+    }
+
+    /* "°C" may be encoded as one or two bytes depending on the source file */
+    while (*unit && ((uint16_t) *unit & 0xFFU) >= 0x80U) {
+        unit++;
+    }
+
+    for (i = 0U; i < CELL_UNIT_N; i++) {
+        if (strcmp(cell_unit[i].unit, unit) == 0) {
+            return cell_unit[i].decimals;
+        }
+    }
+
+    return CELL_DECIMALS_DEFAULT;
+}
+
+/**************************************************************************************************
+ *
+ * cell_page_new()
+ *
+ *************************************************************************************************/
+struct cell_page *
+cell_page_new(void)
+{
+    static struct cell_page cell_page;
+    memset(&cell_page, 0u, sizeof(struct cell_page));
+
+    cell_page.dev = -1;
+    cell_page.page = -1;
+
+    return &cell_page;
+}
+
+/**************************************************************************************************
+ *
+ * cell_page_select()
+ *
+ *************************************************************************************************/
+bool
+cell_page_select(struct cell_page *self, int16_t dev, int16_t page)
+{
+    if (!self || (self->dev == dev && self->page == page)) {
+        return false;
+    }
+
+    self->dev = dev;
+    self->page = page;
+    self->n = 0U;
+
+    return true;
+}
+
+/**************************************************************************************************
+ *
+ * cell_bind()
+ *
+ *************************************************************************************************/
+struct cell *
+cell_bind(struct cell_page *self, uint16_t mesurable, const char *unit, int16_t x, int16_t y,
+    uint16_t w, uint16_t h)
+{
+    if (!self || self->n >= CELL_PAGE_MAX) {
+        return NULL;
+    }
+
+    struct cell *cell = &self->cell[self->n++];
+    memset(cell, 0u, sizeof(struct cell));
+
+    cell->mesurable = mesurable;
+    cell->decimals = cell_decimals(unit);
+
+    cell->x = x;
+    cell->y = y;
+    cell->w = w;
+    cell->h = h;
+
+    return cell;
+}
+
+/**************************************************************************************************
+ *
+ * cell_update()
+ *
+ *************************************************************************************************/
+bool
+cell_update(struct cell *self, float value)
+{
+    if (!self) {
+        return false;
+    }
+
+    int32_t quantum = fmt_scale(value, self->decimals);
+
+    /* Same display step, the cached text is still right */
+    if (self->valid && quantum == self->quantum) {
+        return false;
+    }
+
+    self->quantum = quantum;
+    self->valid = true;
+    self->dirty = true;
+
+    (void) fmt_fixed(self->text, CELL_WIDTH, quantum, self->decimals, NULL);
+
+    return true;
+}
+
+/**************************************************************************************************
+ *
+ * cell_page_update()
+ *
+ *************************************************************************************************/
+uint16_t
+cell_page_update(struct cell_page *self, const struct dev_snap_dev *dev)
+{
+    uint16_t changed = 0U;
+    uint16_t i;
+
+    if (!self || !dev) {
+        return 0U;
+    }
+
+    for (i = 0U; i < self->n; i++) {
+        struct cell *cell = &self->cell[i];
+
+        if (cell->mesurable >= dev->n_mesurables) {
+            continue;
+        }
+
+        if (cell_update(cell, dev->mesurables[cell->mesurable])) {
+            self->formats++;
+            changed++;
+        } else {
+            self->skips++;
+        }
+    }
+
+    return changed;
+}
@@ -0,0 +1,140 @@
+/**************************************************************************************************
+ *
+ * \file cell.h
+ *
+ * \brief Formatted-value cell cache interface. Keeps what every value cell of the current page
+ * shows, so a refresh only formats and redraws the cells whose displayed text changes.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_CELL_H
+#define _APP_CELL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Forward declarations
+ *
+ *************************************************************************************************/
+
+struct dev_snap_dev;
+
+/** Value cells per page                                                                          */
+#define CELL_PAGE_MAX       (12U)
+
+/** Number field of a formatted value (characters), values are right-aligned                    */
+#define CELL_WIDTH          (8U)
+#define CELL_TEXT_LEN       (CELL_WIDTH + 1U)
+
+/**************************************************************************************************
+ *
+ * Value cell. Bound to one mesurable of the device shown by the page.
+ *
+ *************************************************************************************************/
+struct cell {
+    uint16_t mesurable;             /* Mesurable index (dev_snap_dev.mesurables[])              */
+    uint16_t decimals;              /* Digits after the decimal point                           */
+    int32_t quantum;                /* Value shown, times 10^decimals                           */
+    char text[CELL_TEXT_LEN];       /* Value shown, formatted                                   */
+    int16_t x;                      /* Bounds on the frame (pixels)                             */
+    int16_t y;
+    uint16_t w;
+    uint16_t h;
+    bool valid;                     /* False until the first value was formatted                */
+    bool dirty;                     /* Text changed, cleared by the page once redrawn           */
+};
+
+/**************************************************************************************************
+ *
+ * Cell cache of the page being shown
+ *
+ *************************************************************************************************/
+struct cell_page {
+    int16_t dev;                    /* Device registry slot shown, -1 if none                   */
+    int16_t page;                   /* Page shown, -1 if none                                   */
+    uint16_t n;                     /* Cells bound                                              */
+    struct cell cell[CELL_PAGE_MAX];
+    uint32_t formats;               /* Values formatted since start-up                          */
+    uint32_t skips;                 /* Values left as they were since start-up                  */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new cell cache
+ *
+ * \param None
+ *
+ * \return Cell cache object handler
+ *
+ *************************************************************************************************/
+extern struct cell_page *
+cell_page_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Selects page being shown. Cells are unbound when the device or page changes, so the
+ * page binds them again while it draws its static parts.
+ *
+ * \param self cell cache object handler
+ * \param dev device registry slot
+ * \param page page index
+ *
+ * \return True if the page changed and cells must be bound again; false otherwise
+ *
+ *************************************************************************************************/
+extern bool
+cell_page_select(struct cell_page *self, int16_t dev, int16_t page);
+
+/**************************************************************************************************
+ *
+ * \brief Binds a cell to a mesurable. Display resolution follows from the unit string returned
+ * by DEV_mesurables_to_str().
+ *
+ * \param self cell cache object handler
+ * \param mesurable mesurable index
+ * \param unit unit string, e.g. "V"; NULL or unknown units use the default resolution
+ * \param x left edge of the value (pixels)
+ * \param y top edge of the value (pixels)
+ * \param w width reserved for the value (pixels)
+ * \param h height of the value (pixels)
+ *
+ * \return Cell if successful; NULL if the page has no free cells
+ *
+ *************************************************************************************************/
+extern struct cell *
+cell_bind(struct cell_page *self, uint16_t mesurable, const char *unit, int16_t x, int16_t y,
+    uint16_t w, uint16_t h);
+
+/**************************************************************************************************
+ *
+ * \brief Feeds a new value to a cell. The value is formatted only if it moved to another display
+ * step; otherwise the cached text is kept.
+ *
+ * \param self cell
+ * \param value new value
+ *
+ * \return True if the text changed and the cell must be redrawn; false otherwise
+ *
+ *************************************************************************************************/
+extern bool
+cell_update(struct cell *self, float value);
+
+/**************************************************************************************************
+ *
+ * \brief Feeds the values of a device snapshot to all cells of the page. Cells whose text
+ * changed are marked dirty.
+ *
+ * \param self cell cache object handler
+ * \param dev device snapshot entry
+ *
+ * \return Number of cells whose text changed with this update
+ *
+ *************************************************************************************************/
+extern uint16_t
+cell_page_update(struct cell_page *self, const struct dev_snap_dev *dev);
+
+#endif /* _APP_CELL_H */
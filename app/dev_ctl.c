@@ -6,6 +6,8 @@
 
 #include "inc/net/can.h"
 #include "app/user.h"
+#include "app/ipc_queue.h"
+#include "app/hapi.h"
 #include "inc/lib/data.h"
 
 
@@ -23,6 +25,251 @@
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
 
+/**************************************************************************************************
+ * 
+ * Device registry index. Open-addressed hash tables (linear probing) keyed by serial number and
+ * by (id, stack). Each bucket holds the device slot + 1, DEV_CTL_INDEX_EMPTY or
+ * DEV_CTL_INDEX_DELETED. The (id, stack) table is a multimap since duplicated stacks are allowed.
+ * 
+ *************************************************************************************************/
+#define DEV_CTL_INDEX_EMPTY     (0U)
+#define DEV_CTL_INDEX_DELETED   (0xFFU)
+#define DEV_CTL_INDEX_MASK      (DEV_CTL_INDEX_SIZE - 1U)
+
+#if DEV_CTL_INDEX_SIZE < (2U * N_DEVICES)
+#error "DEV_CTL_INDEX_SIZE must be at least twice N_DEVICES"
+#endif
+
+
+/**************************************************************************************************
+ * 
+ * Liveness timer wheel. One bucket per millisecond, a device sits in the bucket of its deadline
+ * (modulo DEV_CTL_WHEEL_SIZE) and is only looked at when that bucket comes round. Refreshing a
+ * device just moves its deadline, the entry is moved to the new bucket the next time it is seen.
+ * 
+ *************************************************************************************************/
+#define DEV_CTL_WHEEL_MASK      (DEV_CTL_WHEEL_SIZE - 1U)
+#define DEV_CTL_TICKS_MS        (HAPI_TIMESTAMP_FREQ / 1000UL)
+
+#if (DEV_CTL_WHEEL_SIZE & DEV_CTL_WHEEL_MASK) != 0U
+#error "DEV_CTL_WHEEL_SIZE must be a power of two"
+#endif
+
+
+static void dev_ctl_wheel_insert(struct dev_ctl *self, int i){
+    uint16_t b = (uint16_t) (self->can_dev[i].alive_deadline & DEV_CTL_WHEEL_MASK);
+    self->can_dev[i].wheel_bucket = b;
+    self->can_dev[i].wheel_next = self->wheel[b];
+    self->wheel[b] = (uint8_t) (i + 1);
+    self->can_dev[i].in_wheel = true;
+}
+
+static void dev_ctl_wheel_remove(struct dev_ctl *self, int i){
+    if( !self->can_dev[i].in_wheel ){
+        return;
+    }
+
+    uint8_t *link = &self->wheel[self->can_dev[i].wheel_bucket];
+    while( *link != 0U ){
+        if( *link == (uint8_t) (i + 1) ){
+            *link = self->can_dev[i].wheel_next;
+            break;
+        }
+        link = &self->can_dev[*link - 1U].wheel_next;
+    }
+    self->can_dev[i].in_wheel = false;
+}
+
+static void dev_ctl_touch(struct dev_ctl *self, int i){
+    self->can_dev[i].alive_deadline = self->timestamp + DEV_CTL_ALIVE_TIMEOUT_MS;
+    if( !self->can_dev[i].in_wheel ){
+        dev_ctl_wheel_insert(self, i);
+    }
+}
+
+
+static uint16_t dev_ctl_hash(uint32_t key){
+    //Knuth multiplicative hash, the bucket is the top DEV_CTL_INDEX_BITS bits of the 32-bit product
+    return (uint16_t) (((uint32_t) (key * 2654435761UL)) >> (32 - DEV_CTL_INDEX_BITS));
+}
+
+static uint16_t dev_ctl_hash_sn(uint32_t serial_number){
+    return dev_ctl_hash(serial_number);
+}
+
+static uint16_t dev_ctl_hash_dev(enum nfo_id id, uint8_t stack){
+    return dev_ctl_hash( ((uint32_t) stack << 8) | (uint32_t) (id & 0xFF) );
+}
+
+
+static void dev_ctl_index_insert(uint8_t *index, uint16_t hash, int slot){
+    uint16_t n;
+    for(n=0;n<DEV_CTL_INDEX_SIZE;n++){
+        uint16_t b = (hash + n) & DEV_CTL_INDEX_MASK;
+        if( index[b] == DEV_CTL_INDEX_EMPTY || index[b] == DEV_CTL_INDEX_DELETED ){
+            index[b] = (uint8_t) (slot + 1);
+            return;
+        }
+    }
+}
+
+
+static void dev_ctl_index_remove(uint8_t *index, uint16_t hash, int slot){
+    uint16_t n;
+    for(n=0;n<DEV_CTL_INDEX_SIZE;n++){
+        uint16_t b = (hash + n) & DEV_CTL_INDEX_MASK;
+        if( index[b] == DEV_CTL_INDEX_EMPTY ){
+            return;
+        }
+        if( index[b] == (uint8_t) (slot + 1) ){
+            //keep probe chains intact for the entries behind this one
+            index[b] = DEV_CTL_INDEX_DELETED;
+            return;
+        }
+    }
+}
+
+
+static int dev_ctl_index_find_sn(const struct dev_ctl *self, uint32_t serial_number){
+    uint16_t hash = dev_ctl_hash_sn(serial_number);
+    uint16_t n;
+    for(n=0;n<DEV_CTL_INDEX_SIZE;n++){
+        uint8_t v = self->index_sn[(hash + n) & DEV_CTL_INDEX_MASK];
+        if( v == DEV_CTL_INDEX_EMPTY ){
+            break;
+        }
+        if( v != DEV_CTL_INDEX_DELETED && self->can_dev[v - 1].serial_number == serial_number ){
+            return v - 1;
+        }
+    }
+    return -1;
+}
+
+
+static int dev_ctl_find_next(const struct dev_ctl *self, enum nfo_id id, uint8_t stack, bool present_only, uint16_t *n){
+    uint16_t hash = dev_ctl_hash_dev(id, stack);
+    for(;*n<DEV_CTL_INDEX_SIZE;(*n)++){
+        uint8_t v = self->index_dev[(hash + *n) & DEV_CTL_INDEX_MASK];
+        if( v == DEV_CTL_INDEX_EMPTY ){
+            break;
+        }
+        if( v == DEV_CTL_INDEX_DELETED ){
+            continue;
+        }
+        const struct can_dev *can_dev = &self->can_dev[v - 1];
+        if( can_dev->id == id && can_dev->stack == stack && (!present_only || can_dev->present) ){
+            (*n)++;
+            return v - 1;
+        }
+    }
+    return -1;
+}
+
+
+int dev_ctl_find(const struct dev_ctl *self, enum nfo_id id, uint8_t stack){
+    uint16_t n = 0;
+    return dev_ctl_find_next(self, id, stack, false, &n);
+}
+
+
+int dev_ctl_find_present(const struct dev_ctl *self, enum nfo_id id, uint8_t stack){
+    uint16_t n = 0;
+    return dev_ctl_find_next(self, id, stack, true, &n);
+}
+
+
+static void dev_ctl_mark_duplicates(struct dev_ctl *self, int i){
+    enum nfo_id id = self->can_dev[i].id;
+    uint8_t stack = self->can_dev[i].stack;
+    uint16_t n = 0;
+    int count = 0;
+    int j;
+
+    while( (j = dev_ctl_find_next(self, id, stack, false, &n)) >= 0 ){
+        if( ++count > 1 ){
+            break;
+        }
+    }
+
+    if( count > 1 ){
+        n = 0;
+        while( (j = dev_ctl_find_next(self, id, stack, false, &n)) >= 0 ){
+            self->can_dev[j].duplicated_stack = true;
+        }
+    }
+}
+
+
+static void dev_ctl_reindex(struct dev_ctl *self){
+    //drop tombstones once they start to lengthen the probe chains
+    memset(self->index_sn, DEV_CTL_INDEX_EMPTY, sizeof(self->index_sn));
+    memset(self->index_dev, DEV_CTL_INDEX_EMPTY, sizeof(self->index_dev));
+    self->index_deleted = 0;
+
+    int i;
+    for(i=0;i<N_DEVICES;i++){
+        if( self->can_dev[i].id != 0 ){
+            dev_ctl_index_insert(self->index_sn, dev_ctl_hash_sn(self->can_dev[i].serial_number), i);
+            dev_ctl_index_insert(self->index_dev, dev_ctl_hash_dev(self->can_dev[i].id, self->can_dev[i].stack), i);
+        }
+    }
+}
+
+
+static void dev_ctl_index_deleted(struct dev_ctl *self){
+    //every removal leaves a tombstone, rebuild once there are too many
+    if( ++self->index_deleted > (DEV_CTL_INDEX_SIZE / 4U) ){
+        dev_ctl_reindex(self);
+    }
+}
+
+
+void dev_ctl_remove(struct dev_ctl *self, int i){
+    if( i < 0 || i >= N_DEVICES || self->can_dev[i].id == 0 ){
+        return;
+    }
+
+    dev_ctl_index_remove(self->index_sn, dev_ctl_hash_sn(self->can_dev[i].serial_number), i);
+    dev_ctl_index_remove(self->index_dev, dev_ctl_hash_dev(self->can_dev[i].id, self->can_dev[i].stack), i);
+
+    //a VG11 pair loses its partner
+    struct can_dev *paired = (struct can_dev *) self->can_dev[i].paired;
+    dev_ctl_wheel_remove(self, i);
+
+    if( paired != NULL && paired->paired == &self->can_dev[i] ){
+        paired->paired = NULL;
+        paired->paired_slave = false;
+        dev_ctl_bind_ops(paired);
+    }
+
+    memset( &self->can_dev[i], 0u, sizeof(struct can_dev));
+    self->generation++;
+
+    dev_ctl_index_deleted(self);
+}
+
+
+static int dev_ctl_alloc(struct dev_ctl *self){
+    int i;
+    //find a free spot
+    for(i=0;i<N_DEVICES;i++){
+        if (self->can_dev[i].id  == 0){
+            return i;
+        }
+    }
+
+    //registry is full, recycle the slot of a device which is no longer present
+    for(i=0;i<N_DEVICES;i++){
+        if (self->can_dev[i].present == false){
+            dev_ctl_remove(self, i);
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
 struct dev_ctl * dev_ctl_new(const struct tlo *tlo)
 {
 
@@ -32,6 +279,7 @@ struct dev_ctl * dev_ctl_new(const struct tlo *tlo)
 
     static struct dev_ctl dev_ctl; // Allocate memory for dev_ctl
     memset(&dev_ctl, 0u, sizeof(struct dev_ctl));
+    dev_ctl.hw_timestamp = hapi_timestamp();
 
 
     return &dev_ctl;
@@ -40,22 +288,88 @@ struct dev_ctl * dev_ctl_new(const struct tlo *tlo)
 
 
 void dev_ctl_check_alive(struct dev_ctl *dev_ctl){
-
-    int i;
-    for(i=0;i< N_DEVICES ;i++){
-        if(dev_ctl->can_dev[i].present == true){
-            if( abs(dev_ctl->can_dev[i].alive_count - dev_ctl->timestamp) > 3000){ //3sec
-                    dev_ctl->can_dev[i].present = false;
-            } 
+    uint16_t b = (uint16_t) (dev_ctl->timestamp & DEV_CTL_WHEEL_MASK);
+    uint8_t *link = &dev_ctl->wheel[b];
+
+    while( *link != 0U ){
+        int i = *link - 1;
+        struct can_dev *can_dev = &dev_ctl->can_dev[i];
+
+        if( (int32_t) (dev_ctl->timestamp - can_dev->alive_deadline) >= 0 ){
+            //deadline reached without hearing from the device
+            *link = can_dev->wheel_next;
+            can_dev->in_wheel = false;
+            can_dev->present = false;
+            dev_ctl->generation++;
+        }
+        else if( (can_dev->alive_deadline & DEV_CTL_WHEEL_MASK) != b ){
+            //refreshed since it was filed, move it to the bucket of its new deadline
+            *link = can_dev->wheel_next;
+            dev_ctl_wheel_insert(dev_ctl, i);
+        }
+        else{
+            //due on a later turn of the wheel
+            link = &can_dev->wheel_next;
         }
-           
     }
+}
 
+void dev_ctl_update_timestamp(struct dev_ctl *dev_ctl){
+    //whole ms elapsed on the hardware counter, the remainder is carried to the next call
+    uint32_t ms = (hapi_timestamp() - dev_ctl->hw_timestamp) / DEV_CTL_TICKS_MS;
+    dev_ctl->hw_timestamp += ms * DEV_CTL_TICKS_MS;
 
+    //after a full turn of the wheel every bucket has been walked once, skip the rest
+    if( ms > DEV_CTL_WHEEL_SIZE ){
+        dev_ctl->timestamp += ms - DEV_CTL_WHEEL_SIZE;
+        ms = DEV_CTL_WHEEL_SIZE;
+    }
+
+    while( ms-- > 0U ){
+        dev_ctl->timestamp++;
+        dev_ctl_check_alive(dev_ctl);
+    }
 }
 
-void dev_ctl_update_timestamp(struct dev_ctl *dev_ctl){
-    dev_ctl->timestamp ++;
+int dev_ctl_request(struct dev_ctl *self, const struct ipc_msg *msg){
+    if( self == NULL || msg == NULL || msg->dev >= N_DEVICES ){
+        return -1;
+    }
+
+    //the user interface may still show a device that has left or moved since
+    struct can_dev *can_dev = &self->can_dev[msg->dev];
+    if( !can_dev->present || can_dev->id != (enum nfo_id) msg->id || can_dev->stack != msg->stack ){
+        return -1;
+    }
+
+    //requests are picked up by can_tx_scan() in the next CAN job
+    switch( msg->type ){
+        case IPC_MSG_ON:
+            can_dev->request_on = (msg->arg != 0U);
+            break;
+        case IPC_MSG_MODE:
+            can_dev->request_mode = (int) msg->arg;
+            break;
+        case IPC_MSG_CLEAR:
+            can_dev->clear_interlock = (msg->arg != 0U);
+            break;
+        case IPC_MSG_SETPOINT: {
+            //end is one past the last setpoint, and for the VG11 pair spans both modules
+            if( (int) msg->arg >= DEV_setpoints_enum_end(can_dev) ||
+                msg->arg >= sizeof(can_dev->setpoints)/sizeof(can_dev->setpoints[0]) ){
+                return -1;
+            }
+            double value = msg->value;
+            DEV_setpoints_check(can_dev, msg->arg, &value);
+            can_dev->setpoints[msg->arg] = (float) value;
+            can_dev->setpoint_changed = true;
+            break;
+        }
+        default:
+            return -1;
+    }
+
+    return 0;
 }
 
 int dev_ctl_find_last_devices(const struct tlo  *tlo, enum nfo_id  exp_id ){
@@ -68,26 +382,30 @@ int dev_ctl_find_last_devices(const struct tlo  *tlo, enum nfo_id  exp_id ){
         return -1;
     }
 
-    struct dev_ctl *self = (struct dev_ctl *)tlo->dev_ctl;
+    const struct dev_ctl *self = tlo->dev_ctl;
     uint16_t device_id = self->last_dev_id;
- 
 
-    int i;
-    for(i=0;i<N_DEVICES;i++){
-        //devices already there 
-        //if (  self->can_dev[i].present == true){
-                volatile uint8_t _id = self->can_dev[i].id ;
-                if(_id  == exp_id){
-                    volatile uint8_t _stack = self->can_dev[i].stack;
-                    volatile uint16_t _device_id =   ((uint16_t)  _stack  << 8  )    |   _id;
-                    if(device_id == _device_id){
-                        return i;
-                    }
-                }
-        //}
+    if( (device_id & 0xFF) != exp_id ){
+        return -1;
     }
-    return -1;
 
+    return dev_ctl_find(self, exp_id, (uint8_t) (device_id >> 8));
+
+}
+
+
+bool dev_ctl_sniffing(const struct tlo *tlo){
+    //states that list the devices on the bus, the only ones that take device type broadcasts
+    if( tlo->state_machine == NULL ){
+        return false;
+    }
+
+    return tlo->state_machine->currentState == state_sniffer_stack ||
+        tlo->state_machine->currentState == state_sniffer_version ||
+        tlo->state_machine->currentState == state_sniffer_interlock ||
+        tlo->state_machine->currentState == state_select_superset ||
+        tlo->state_machine->currentState == state_welcome ||
+        tlo->state_machine->currentState == state_set_module;
 }
 
 
@@ -109,13 +427,7 @@ bool dev_ctl_update_devices(const struct tlo  *tlo, const struct can_f *f){
     //alive is bof
 
 
-    if( tlo->state_machine->currentState != state_sniffer_stack &&
-        tlo->state_machine->currentState != state_sniffer_version &&
-        tlo->state_machine->currentState != state_sniffer_interlock &&
-        tlo->state_machine->currentState != state_select_superset &&
-        tlo->state_machine->currentState != state_welcome &&
-        tlo->state_machine->currentState != state_set_module){
-    
+    if( !dev_ctl_sniffing(tlo) ){
         return false;
     }
 
@@ -152,107 +464,91 @@ bool dev_ctl_update_devices(const struct tlo  *tlo, const struct can_f *f){
         return false;
     }
 
-    int i;
+    int i = dev_ctl_index_find_sn(self, serial_number);
 
-    bool devices_was_register = false;
-    for(i=0;i<N_DEVICES;i++){
-        //devices already there 
-        if ( self->can_dev[i].serial_number  == serial_number ){
-            //update this already present device
+    if( i >= 0){
+        //update this already present device
+        if( !self->can_dev[i].present || self->can_dev[i].id != id || self->can_dev[i].stack != stack ){
+            self->generation++;
+        }
+        bool type_changed = (self->can_dev[i].id != id);
+        if( self->can_dev[i].id != id || self->can_dev[i].stack != stack ){
+            //the moved entry goes through the counted delete so its tombstone is reclaimed
+            dev_ctl_index_remove(self->index_dev, dev_ctl_hash_dev(self->can_dev[i].id, self->can_dev[i].stack), i);
+            self->can_dev[i].id = (enum nfo_id) id;
+            self->can_dev[i].stack = stack;
+            dev_ctl_index_insert(self->index_dev, dev_ctl_hash_dev(id, stack), i);
+            dev_ctl_index_deleted(self);
+        }
+        self->can_dev[i].id = (enum nfo_id) id;
+        self->can_dev[i].hw_rev = rev;
+        self->can_dev[i].hw_var = var;
+        self->can_dev[i].stack =  stack;
+        self->can_dev[i].present = true;
+        self->can_dev[i].compatible = device_is_supported((enum nfo_id) id);
+        if( type_changed ){
+            //values of the previous device type mean nothing to the new one
+            memset(self->can_dev[i].mesurables, 0u, sizeof(self->can_dev[i].mesurables));
+            memset(self->can_dev[i].setpoints, 0u, sizeof(self->can_dev[i].setpoints));
+        }
+        dev_ctl_touch(self, i);
+        self->can_dev[i].serial_number = serial_number ;
+        self->can_dev[i].duplicated_stack = false;
+
+        self->can_dev[i].paired = NULL;
+
+        if(id == NFO_VG11_FM01 || id == NFO_VG11_FM02 ){
+            //check is have a pair
+            enum nfo_id pair_id = (id == NFO_VG11_FM01) ? NFO_VG11_FM02 : NFO_VG11_FM01;
+            int j = dev_ctl_find_present(self, pair_id, stack);
+            if( j >= 0 ){
+                self->can_dev[i].paired = &self->can_dev[j];
+                self->can_dev[j].paired = &self->can_dev[i];
+                dev_ctl_bind_ops(&self->can_dev[j]);
+            }
+        }
+        dev_ctl_bind_ops(&self->can_dev[i]);
+
+        if(id == NFO_VG11_FM02){
+            if(self->can_dev[i].paired != NULL){
+                    self->can_dev[i].paired_slave = true;
+            }
+        }
+    }
+    else{
+        //add a  devices
+        i = dev_ctl_alloc(self);
+        if( i >= 0 ){
+        
+            self->can_dev[i].custom_mesurables[0] = 0;
+            self->can_dev[i].custom_mesurables[1] = 1;
+            self->can_dev[i].custom_mesurables[2] = 2;
+            self->can_dev[i].custom_mesurables[3] = 3;
+      
             self->can_dev[i].id = (enum nfo_id) id;
             self->can_dev[i].hw_rev = rev;
             self->can_dev[i].hw_var = var;
             self->can_dev[i].stack =  stack;
             self->can_dev[i].present = true;
             self->can_dev[i].compatible = device_is_supported((enum nfo_id) id);
-            devices_was_register = true;
-            self->can_dev[i].alive_count = tlo->dev_ctl->timestamp;
+            dev_ctl_touch(self, i);
             self->can_dev[i].serial_number = serial_number ;
             self->can_dev[i].duplicated_stack = false;
-
             self->can_dev[i].paired = NULL;
-    
-            if(id == NFO_VG11_FM01 || id == NFO_VG11_FM02 ){
-                //check is have a pair
-                int j = 0;
-                for(j=0;j<N_DEVICES;j++){ 
-                        if( self->can_dev[j].present == true){
-                            if(self->can_dev[i].stack ==  self->can_dev[j].stack){
-                                if( (self->can_dev[j].id != id) && ( self->can_dev[j].id  == NFO_VG11_FM01 ||  self->can_dev[j].id  == NFO_VG11_FM02  ) ){
-                                            self->can_dev[i].paired = &self->can_dev[j];
-                                            self->can_dev[j].paired = &self->can_dev[i];
-                                            break;
-                                }
-                            }
-                        }
-                }
-            }
+            self->can_dev[i].paired_slave = false;
+            self->can_dev[i].part_of_ss = false;
+            dev_ctl_bind_ops(&self->can_dev[i]);
+            self->generation++;
 
-            if(id == NFO_VG11_FM02){
-                if(self->can_dev[i].paired != NULL){
-                        self->can_dev[i].paired_slave = true;
-                }
-            }
-           
-
-
-            break;
+            dev_ctl_index_insert(self->index_sn, dev_ctl_hash_sn(serial_number), i);
+            dev_ctl_index_insert(self->index_dev, dev_ctl_hash_dev(id, stack), i);
         }
     }
 
-    if( ! devices_was_register){
-        //add a  devices
-        for(i=0;i<N_DEVICES;i++){
-            //find a free sport
-            if (self->can_dev[i].id  == 0){
-            
-                self->can_dev[i].custom_mesurables[0] = 0;
-                self->can_dev[i].custom_mesurables[1] = 1;
-                self->can_dev[i].custom_mesurables[2] = 2;
-                self->can_dev[i].custom_mesurables[3] = 3;
-          
-                self->can_dev[i].id = (enum nfo_id) id;
-                self->can_dev[i].hw_rev = rev;
-                self->can_dev[i].hw_var = var;
-                self->can_dev[i].stack =  stack;
-                self->can_dev[i].present = true;
-                self->can_dev[i].compatible = device_is_supported((enum nfo_id) id);  //&  no_malloc_error;
-                self->can_dev[i].alive_count = tlo->dev_ctl->timestamp;
-                self->can_dev[i].serial_number = serial_number ;
-                self->can_dev[i].duplicated_stack = false;
-                self->can_dev[i].paired = NULL;
-                self->can_dev[i].paired_slave = false;
-                self->can_dev[i].part_of_ss = false;
-                
-            
-                break;
-            }
-        }
-    }
-
-
-    //check for colision
-    int j = 0;
-    for(i=0;i< N_DEVICES -1 ;i++){
-        for (j = i + 1; j < N_DEVICES ; ++j) {
-
-            if (  self->can_dev[i].id  == self->can_dev[j].id) {
-                if (  self->can_dev[i].stack  == self->can_dev[j].stack) {
-                    self->can_dev[i].duplicated_stack = true;
-                    self->can_dev[j].duplicated_stack = true;
-
-                }
-                
-            }
-
-                
-         }
-    }
-
 
-    if(self->can_dev[i].present == false){
-        //delete only in some mode
-         memset( &self->can_dev[i], 0u, sizeof(struct can_dev));
+    //check for colision, only devices sharing (id, stack) with this one can collide
+    if( i >= 0 ){
+        dev_ctl_mark_duplicates(self, i);
     }
     
     return true;
@@ -337,7 +633,9 @@ int change_device_stack( const struct net *net, const struct dev_ctl * self ,  i
     f.data[2+2] =  (serial_number >>  (8*1)) & 0xFF;
     f.data[2+3] =  (serial_number >>  (8*0)) & 0xFF;
   
+    hapi_can_lock(true);
     int ret = can_write(net, &f);
+    hapi_can_lock(false);
     return ret;
 }
 
@@ -346,365 +644,324 @@ int change_device_stack( const struct net *net, const struct dev_ctl * self ,  i
 
 
 
-const char* DEV_fault_to_str(const struct can_dev *can_dev,int fault){
-    
-    if( fault > DEV_fault_enum_end(can_dev) ){ return false;}
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_fault_to_str( (enum BP25_fault) fault);
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            const char * _fault = VG11_FM02_fault_to_str( (enum VG11_FM02_fault) fault);
-            if( _fault[0] == '!'){
-                return VG11_FM01_fault_to_str( (enum VG11_FM01_fault) fault);
-            }
-            return _fault;    
-       
-        }
-    case NFO_VG11_FM02 :
-        return VG11_FM02_fault_to_str( (enum VG11_FM02_fault) fault);
+/**************************************************************************************************
+ * 
+ * Driver ops tables. Each driver function takes its own enum, the adapters below give them the
+ * common dev_ops signature.
+ * 
+ *************************************************************************************************/
+#define DEV_OPS_ADAPTERS(DRV)                                                                       \
+static const char* DRV##_ops_fault_to_str(const struct can_dev *can_dev, int fault){               \
+    return DRV##_fault_to_str( (enum DRV##_fault) fault);                                           \
+}                                                                                                   \
+static bool DRV##_ops_mode_is_supported(const struct can_dev *can_dev, int mode){                  \
+    return DRV##_mode_is_supported( (enum DRV##_mode) mode);                                        \
+}                                                                                                   \
+static const char* DRV##_ops_mode_to_str(const struct can_dev *can_dev, int mode){                 \
+    return DRV##_mode_to_str( (enum DRV##_mode) mode);                                              \
+}                                                                                                   \
+static const unsigned char* DRV##_ops_mode_to_icon(const struct can_dev *can_dev, int mode){       \
+    return DRV##_mode_to_icon( (enum DRV##_mode) mode);                                             \
+}                                                                                                   \
+static int DRV##_ops_mesurables_view_param(const struct can_dev *can_dev, int mesurable, enum VIEW_PARAM param){ \
+    return DRV##_mesurables_view_param( (enum DRV##_mesurables) mesurable, (int) param);            \
+}                                                                                                   \
+static const char* DRV##_ops_mesurables_to_str(const struct can_dev *can_dev, int mesurable, enum STRING_PARAM param){ \
+    return DRV##_mesurables_to_str( (enum DRV##_mesurables) mesurable, (int) param);                \
+}                                                                                                   \
+static const char* DRV##_ops_setpoints_to_str(const struct can_dev *can_dev, int setpoint, enum STRING_PARAM param){ \
+    return DRV##_setpoints_to_str( (enum DRV##_setpoints) setpoint, (int) param);                   \
+}                                                                                                   \
+static double DRV##_ops_setables_param(const struct can_dev *can_dev, int setpoint, enum SETABLE_PARAM param){ \
+    return DRV##_setables_param( (enum DRV##_setpoints) setpoint, (int) param);                     \
+}                                                                                                   \
+static void DRV##_ops_setpoints_check(const struct can_dev *can_dev, int setpoint, double* value){ \
+    DRV##_setpoints_check( (enum DRV##_setpoints) setpoint, value);                                 \
+}                                                                                                   \
+static int DRV##_ops_mode_main_view(const struct can_dev *can_dev, int mode, int param){           \
+    return DRV##_mode_main_view( (enum DRV##_mode) mode, param);                                    \
+}
 
-    
-    default:
-        return false;
+DEV_OPS_ADAPTERS(BP25)
+DEV_OPS_ADAPTERS(VG11_FM01)
+DEV_OPS_ADAPTERS(VG11_FM02)
 
-    }
+
+static double dev_ops_get_mesurables(const struct can_dev *can_dev, int mesurable){
+    return can_dev->mesurables[mesurable];
 }
 
 
-bool DEV_mode_is_supported(const struct can_dev *can_dev,int mode){
+#define DEV_OPS_TABLE(DRV, TEMP) {                                                                  \
+    .mode_end               = enum_##DRV##_mode_end,                                                \
+    .setpoints_end          = enum_##DRV##_setpoints_end,                                           \
+    .mesurables_end         = enum_##DRV##_mesurables_end,                                          \
+    .fault_end              = enum_##DRV##_fault_end,                                               \
+    .temp                   = TEMP,                                                                 \
+    .fault_to_str           = DRV##_ops_fault_to_str,                                               \
+    .mode_is_supported      = DRV##_ops_mode_is_supported,                                          \
+    .mode_to_str            = DRV##_ops_mode_to_str,                                                \
+    .mode_to_icon           = DRV##_ops_mode_to_icon,                                               \
+    .mesurables_view_param  = DRV##_ops_mesurables_view_param,                                      \
+    .get_mesurables         = dev_ops_get_mesurables,                                               \
+    .mesurables_to_str      = DRV##_ops_mesurables_to_str,                                          \
+    .setpoints_to_str       = DRV##_ops_setpoints_to_str,                                           \
+    .setables_param         = DRV##_ops_setables_param,                                             \
+    .setpoints_check        = DRV##_ops_setpoints_check,                                            \
+    .mode_main_view         = DRV##_ops_mode_main_view,                                             \
+}
 
-    if( mode > DEV_mode_enum_end(can_dev) ){ return false;}
+static const struct dev_ops dev_ops_bp25 = DEV_OPS_TABLE(BP25, BP25_temp_bridge);
+static const struct dev_ops dev_ops_vg11_fm01 = DEV_OPS_TABLE(VG11_FM01, VG11_FM01_temp_bridge);
+static const struct dev_ops dev_ops_vg11_fm02 = DEV_OPS_TABLE(VG11_FM02, VG11_FM02_temp_bridge);
 
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_mode_is_supported( (enum BP25_mode) mode);
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            return VG11_FM02_mode_is_supported( (enum VG11_FM02_mode) mode);
-        }
-        return VG11_FM01_mode_is_supported( (enum VG11_FM01_mode) mode);
-    case NFO_VG11_FM02 :
-        return VG11_FM02_mode_is_supported( (enum VG11_FM02_mode) mode);
-    default:
-        return false;
 
+//VG11 FM01 paired with FM02 is shown as one device: FM01 mesurables first, then FM02 ones
+static const char* vg11_pair_ops_fault_to_str(const struct can_dev *can_dev, int fault){
+    const char * _fault = VG11_FM02_fault_to_str( (enum VG11_FM02_fault) fault);
+    if( _fault[0] == '!'){
+        return VG11_FM01_fault_to_str( (enum VG11_FM01_fault) fault);
     }
-
+    return _fault;
 }
 
+static int vg11_pair_ops_mesurables_view_param(const struct can_dev *can_dev, int mesurable, enum VIEW_PARAM param){
+    if( mesurable > (enum_VG11_FM01_mesurables_end - 1)){
+        int res =  VG11_FM02_mesurables_view_param( (enum VG11_FM02_mesurables) (mesurable - enum_VG11_FM01_mesurables_end), (int) param) ;
+        if(param == VIEW_PARAM_PAGE ){
+             res += 6; //find max page
+        }
+        return res ;
+    }
+    return VG11_FM01_mesurables_view_param( (enum VG11_FM01_mesurables) (mesurable ), (int) param) ;
+}
 
-const char* DEV_mode_to_str(const struct can_dev *can_dev,int mode){
-
-    
-    if( mode > DEV_mode_enum_end(can_dev) ){   return "NAN";}
-
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_mode_to_str( (enum BP25_mode) mode);
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            return VG11_FM02_mode_to_str( (enum VG11_FM02_mode) mode);
+static double vg11_pair_ops_get_mesurables(const struct can_dev *can_dev, int mesurable){
+    if( mesurable > (enum_VG11_FM01_mesurables_end-1)){
+        const struct can_dev* can_dev_p = can_dev->paired;
+        if(mesurable ==  (VG11_FM02_energized + enum_VG11_FM01_mesurables_end) ){
+            return MAX(  can_dev->mesurables[VG11_FM01_energized] ,  can_dev_p->mesurables[VG11_FM02_energized]  );
         }
-        return VG11_FM01_mode_to_str( (enum VG11_FM01_mode) mode);
-    case NFO_VG11_FM02 :
-        return VG11_FM02_mode_to_str( (enum VG11_FM02_mode) mode);
-    default:
-        return "NAN";
+        return can_dev_p->mesurables[mesurable - enum_VG11_FM01_mesurables_end];
+    }
+    return can_dev->mesurables[mesurable];
+}
 
+static const char* vg11_pair_ops_mesurables_to_str(const struct can_dev *can_dev, int mesurable, enum STRING_PARAM param){
+    if( mesurable > (enum_VG11_FM01_mesurables_end -1)){
+        return VG11_FM02_mesurables_to_str( (enum VG11_FM02_mesurables) (mesurable - enum_VG11_FM01_mesurables_end) , (int) param);
     }
+    return VG11_FM01_mesurables_to_str( (enum VG11_FM01_mesurables) mesurable , (int) param) ;
+}
 
+static int vg11_pair_ops_mode_main_view(const struct can_dev *can_dev, int mode, int param){
+    return VG11_mode_main_view( mode , param);
 }
 
+static const struct dev_ops dev_ops_vg11_pair = {
+    .mode_end               = enum_VG11_FM02_mode_end + enum_VG11_FM01_mode_end,
+    .setpoints_end          = enum_VG11_FM01_setpoints_end + enum_VG11_FM02_setpoints_end,
+    .mesurables_end         = enum_VG11_FM01_mesurables_end + enum_VG11_FM02_mesurables_end,
+    .fault_end              = MAX((int) enum_VG11_FM01_fault_end, (int) enum_VG11_FM02_fault_end),
+    .temp                   = VG11_FM01_temp_bridge,
+    .fault_to_str           = vg11_pair_ops_fault_to_str,
+    .mode_is_supported      = VG11_FM02_ops_mode_is_supported,
+    .mode_to_str            = VG11_FM02_ops_mode_to_str,
+    .mode_to_icon           = VG11_FM02_ops_mode_to_icon,
+    .mesurables_view_param  = vg11_pair_ops_mesurables_view_param,
+    .get_mesurables         = vg11_pair_ops_get_mesurables,
+    .mesurables_to_str      = vg11_pair_ops_mesurables_to_str,
+    .setpoints_to_str       = VG11_FM02_ops_setpoints_to_str,
+    .setables_param         = VG11_FM02_ops_setables_param,
+    .setpoints_check        = VG11_FM02_ops_setpoints_check,
+    .mode_main_view         = vg11_pair_ops_mode_main_view,
+};
+
+
+//Unknown or unsupported devices, and free slots
+static const char* none_ops_to_str(const struct can_dev *can_dev, int index){
+    return "NAN";
+}
 
+static bool none_ops_mode_is_supported(const struct can_dev *can_dev, int mode){
+    return false;
+}
 
-const unsigned char*  DEV_mode_to_icon(const struct can_dev *can_dev,int mode){
+static const unsigned char* none_ops_mode_to_icon(const struct can_dev *can_dev, int mode){
+    return icon_none;
+}
 
-    if( mode > DEV_mode_enum_end(can_dev) ){   return icon_none;}
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_mode_to_icon( (enum BP25_mode) mode) ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            return VG11_FM02_mode_to_icon( (enum VG11_FM02_mode) mode);
-        }
-        return VG11_FM01_mode_to_icon( (enum VG11_FM01_mode) mode);
-    case NFO_VG11_FM02 :
-        return VG11_FM02_mode_to_icon( (enum VG11_FM02_mode) mode);
-    default:
-        return icon_none;
-    }
+static int none_ops_mesurables_view_param(const struct can_dev *can_dev, int mesurable, enum VIEW_PARAM param){
+    return 0;
+}
 
+static double none_ops_get_mesurables(const struct can_dev *can_dev, int mesurable){
+    return 0;
 }
 
+static const char* none_ops_param_to_str(const struct can_dev *can_dev, int index, enum STRING_PARAM param){
+    return "NAN";
+}
 
-int DEV_mesurables_view_param(const struct can_dev *can_dev,int  mesurable, enum VIEW_PARAM param){
-    
-    if( mesurable > DEV_mesurables_enum_end(can_dev) ){ return 0;}
+static double none_ops_setables_param(const struct can_dev *can_dev, int setpoint, enum SETABLE_PARAM param){
+    return 0;
+}
+
+static void none_ops_setpoints_check(const struct can_dev *can_dev, int setpoint, double* value){
+}
 
+static int none_ops_mode_main_view(const struct can_dev *can_dev, int mode, int param){
+    return 0;
+}
+
+static const struct dev_ops dev_ops_none = {
+    .mode_end               = 0,
+    .setpoints_end          = 0,
+    .mesurables_end         = 0,
+    .fault_end              = 0,
+    .temp                   = -1,
+    .fault_to_str           = none_ops_to_str,
+    .mode_is_supported      = none_ops_mode_is_supported,
+    .mode_to_str            = none_ops_to_str,
+    .mode_to_icon           = none_ops_mode_to_icon,
+    .mesurables_view_param  = none_ops_mesurables_view_param,
+    .get_mesurables         = none_ops_get_mesurables,
+    .mesurables_to_str      = none_ops_param_to_str,
+    .setpoints_to_str       = none_ops_param_to_str,
+    .setables_param         = none_ops_setables_param,
+    .setpoints_check        = none_ops_setpoints_check,
+    .mode_main_view         = none_ops_mode_main_view,
+};
+
+
+#define DEV_OPS(can_dev) ((can_dev)->ops != NULL ? (can_dev)->ops : &dev_ops_none)
+
+
+void dev_ctl_bind_ops(struct can_dev *can_dev){
     switch (can_dev->id)
     {
     case NFO_BP25 :
-        return BP25_mesurables_view_param( (enum BP25_mesurables) mesurable , (int) param) ;
+        can_dev->ops = &dev_ops_bp25;
+        break;
     case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL  && mesurable > (enum_VG11_FM01_mesurables_end - 1)){
-            int res =  VG11_FM02_mesurables_view_param( (enum VG11_FM02_mesurables) (mesurable - enum_VG11_FM01_mesurables_end), (int) param) ;
-            if(param == VIEW_PARAM_PAGE ){
-                 res += 6; //find max page
-            }
-            return res ;
-        }
-        return VG11_FM01_mesurables_view_param( (enum VG11_FM01_mesurables) (mesurable ), (int) param) ;
+        can_dev->ops = (can_dev->paired != NULL) ? &dev_ops_vg11_pair : &dev_ops_vg11_fm01;
+        break;
     case NFO_VG11_FM02 :
-        return VG11_FM02_mesurables_view_param( (enum VG11_FM02_mesurables) mesurable , (int) param) ;
+        can_dev->ops = &dev_ops_vg11_fm02;
+        break;
     default:
-        return 0;
+        can_dev->ops = &dev_ops_none;
+        break;
     }
-
 }
 
 
 
 
-double DEV_get_mesurables(const struct can_dev *can_dev,int  mesurable){
+const char* DEV_fault_to_str(const struct can_dev *can_dev,int fault){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( fault > ops->fault_end ){ return false;}
+    return ops->fault_to_str(can_dev, fault);
+}
 
-    if( mesurable > DEV_mesurables_enum_end(can_dev) ){   return 0;}
 
-    switch (can_dev->id)
-    {
-
-    case NFO_BP25 :
-        return can_dev->mesurables[mesurable];
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL && mesurable > (enum_VG11_FM01_mesurables_end-1)){
-            const struct can_dev* can_dev_p = can_dev->paired;
-            if(mesurable ==  (VG11_FM02_energized + enum_VG11_FM01_mesurables_end) ){
-                return MAX(  can_dev->mesurables[VG11_FM01_energized] ,  can_dev_p->mesurables[VG11_FM02_energized]  );
-            }
-            return can_dev_p->mesurables[mesurable - enum_VG11_FM01_mesurables_end];
-        }
-        return can_dev->mesurables[mesurable];
-
-    case NFO_VG11_FM02 :
-        return can_dev->mesurables[mesurable];
-    default:
-        return 0;
-    }
+bool DEV_mode_is_supported(const struct can_dev *can_dev,int mode){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( mode > ops->mode_end ){ return false;}
+    return ops->mode_is_supported(can_dev, mode);
+}
 
 
+const char* DEV_mode_to_str(const struct can_dev *can_dev,int mode){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( mode > ops->mode_end ){   return "NAN";}
+    return ops->mode_to_str(can_dev, mode);
 }
 
 
 
-const char*  DEV_mesurables_to_str(const struct can_dev *can_dev,int  mesurable, enum STRING_PARAM param){
-
-    if( mesurable > DEV_mesurables_enum_end(can_dev) ){   return "NAN";}
+const unsigned char*  DEV_mode_to_icon(const struct can_dev *can_dev,int mode){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( mode > ops->mode_end ){   return icon_none;}
+    return ops->mode_to_icon(can_dev, mode);
+}
 
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_mesurables_to_str( (enum BP25_mesurables) mesurable ,(int) param) ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL && mesurable > (enum_VG11_FM01_mesurables_end -1)){
-            VG11_FM02_mesurables_to_str( (enum VG11_FM02_mesurables) (mesurable - enum_VG11_FM01_mesurables_end) , (int) param);
-        }
-        return VG11_FM01_mesurables_to_str( (enum VG11_FM01_mesurables) mesurable , (int) param) ;
 
-    case NFO_VG11_FM02 :
-        return VG11_FM02_mesurables_to_str( (enum VG11_FM02_mesurables) mesurable , (int) param);
-    default:
-        return "NAN";
-    }
+int DEV_mesurables_view_param(const struct can_dev *can_dev,int  mesurable, enum VIEW_PARAM param){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( mesurable > ops->mesurables_end ){ return 0;}
+    return ops->mesurables_view_param(can_dev, mesurable, param);
+}
 
 
+double DEV_get_mesurables(const struct can_dev *can_dev,int  mesurable){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( mesurable > ops->mesurables_end ){   return 0;}
+    return ops->get_mesurables(can_dev, mesurable);
 }
 
 
-const char* DEV_setpoints_to_str(const struct can_dev *can_dev,int setpoints,  enum STRING_PARAM param ){
-    if( setpoints > DEV_setpoints_enum_end(can_dev) ){   return "NAN";}
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_setpoints_to_str( (enum BP25_setpoints) setpoints , (int) param) ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            return VG11_FM02_setpoints_to_str( (enum VG11_FM02_setpoints) setpoints , (int) param) ;
-        }
-        return VG11_FM01_setpoints_to_str( (enum VG11_FM01_setpoints) setpoints , (int) param) ;
-    case NFO_VG11_FM02 :
-        return VG11_FM02_setpoints_to_str( (enum VG11_FM02_setpoints) setpoints , (int) param) ;
-    default:
-        return "NAN";
-    }
+const char*  DEV_mesurables_to_str(const struct can_dev *can_dev,int  mesurable, enum STRING_PARAM param){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( mesurable > ops->mesurables_end ){   return "NAN";}
+    return ops->mesurables_to_str(can_dev, mesurable, param);
+}
 
 
+const char* DEV_setpoints_to_str(const struct can_dev *can_dev,int setpoints,  enum STRING_PARAM param ){
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( setpoints > ops->setpoints_end ){   return "NAN";}
+    return ops->setpoints_to_str(can_dev, setpoints, param);
 }
 
 
 double DEV_setables_param(const struct can_dev *can_dev,int setpoints, enum SETABLE_PARAM param ){
-    if( setpoints > DEV_setpoints_enum_end(can_dev) ){   return 0;}
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_setables_param( (enum BP25_setpoints) setpoints , (int) param) ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            return VG11_FM02_setables_param( (enum VG11_FM02_setpoints) setpoints , (int) param) ;
-        }
-        return VG11_FM01_setables_param( (enum VG11_FM01_setpoints) setpoints , (int) param) ;
-    case NFO_VG11_FM02 :
-        return VG11_FM02_setables_param( (enum VG11_FM02_setpoints) setpoints , (int) param) ;
-    default:
-        return 0;
-    }
-
-
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( setpoints > ops->setpoints_end ){   return 0;}
+    return ops->setables_param(can_dev, setpoints, param);
 }
 
 
 void DEV_setpoints_check(const struct can_dev *can_dev, int setpoints, double* value){
-    if( setpoints > DEV_setpoints_enum_end(can_dev) ){return ;}
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_setpoints_check( (enum BP25_setpoints) setpoints , value) ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-             return VG11_FM02_setpoints_check( (enum VG11_FM02_setpoints) setpoints , value);
-        }
-        return VG11_FM01_setpoints_check( (enum VG11_FM01_setpoints) setpoints , value) ;
-    case NFO_VG11_FM02 :
-        return VG11_FM02_setpoints_check( (enum VG11_FM02_setpoints) setpoints , value) ;
-    default : 
-        return;
-
-    }
-  
-
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( setpoints > ops->setpoints_end ){return ;}
+    ops->setpoints_check(can_dev, setpoints, value);
 }
 
 
 int DEV_mode_main_view(const struct can_dev *can_dev,int mode,  int param ){
-     
-    if( mode > DEV_mode_enum_end(can_dev) ){return 0;}
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return BP25_mode_main_view( (enum BP25_mode) mode , param) ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-             return VG11_mode_main_view( mode , param);
-        }
-        return VG11_FM01_mode_main_view( (enum VG11_FM01_mode) mode , param);
-    case NFO_VG11_FM02 : 
-        return VG11_FM02_mode_main_view( (enum VG11_FM02_mode) mode , param);
-    default:
-        return 0;
-    }
-
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( mode > ops->mode_end ){return 0;}
+    return ops->mode_main_view(can_dev, mode, param);
 }
 
 
 
 int DEV_mode_enum_end(const struct can_dev *can_dev){
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return enum_BP25_mode_end ;
-    case NFO_VG11_FM01 :
-       if(can_dev->paired != NULL){
-            return( enum_VG11_FM02_mode_end + enum_VG11_FM01_mode_end);
-        }
-        return enum_VG11_FM01_mode_end ;
-    case NFO_VG11_FM02 :
-        return enum_VG11_FM02_mode_end ;
-    default:
-        return 0;
-    }
-
+    return DEV_OPS(can_dev)->mode_end;
 }
 
 
-
 int DEV_setpoints_enum_end(const struct can_dev *can_dev){
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return enum_BP25_setpoints_end;
-     case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            return( enum_VG11_FM01_setpoints_end + enum_VG11_FM02_setpoints_end);
-        }
-
-        return enum_VG11_FM01_setpoints_end ;
-     case NFO_VG11_FM02 :
-        return enum_VG11_FM02_setpoints_end ;
-    default:
-        return 0;
-    }
-
+    return DEV_OPS(can_dev)->setpoints_end;
 }
 
 
 int DEV_mesurables_enum_end(const struct can_dev *can_dev){
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return enum_BP25_mesurables_end ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-            return( enum_VG11_FM01_mesurables_end + enum_VG11_FM02_mesurables_end);
-        }
-        return enum_VG11_FM01_mesurables_end ;
-    case NFO_VG11_FM02 :
-        return enum_VG11_FM02_mesurables_end ;
-    default:
-        return 0;
-    }
-
+    return DEV_OPS(can_dev)->mesurables_end;
 }
 
 
-
 int DEV_fault_enum_end(const struct can_dev *can_dev){
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return enum_BP25_fault_end ;
-    case NFO_VG11_FM01 :
-        if(can_dev->paired != NULL){
-                return MAX(enum_VG11_FM01_fault_end,enum_VG11_FM02_fault_end);
-        }
-        return enum_VG11_FM01_fault_end ;
-    case NFO_VG11_FM02 :
-        return enum_VG11_FM02_fault_end ;
-    default:
-        return 0;
-    }
-
+    return DEV_OPS(can_dev)->fault_end;
 }
 
 
 
-
-
 double DEV_get_temp(const struct can_dev *can_dev){
-    switch (can_dev->id)
-    {
-    case NFO_BP25 :
-        return can_dev->mesurables[BP25_temp_bridge] ;
-    case NFO_VG11_FM01 :
-        return can_dev->mesurables[VG11_FM01_temp_bridge];
-    case NFO_VG11_FM02 :
-        return  can_dev->mesurables[VG11_FM02_temp_bridge];
-    default:
-        return 0;
-    }
-
+    const struct dev_ops *ops = DEV_OPS(can_dev);
+    if( ops->temp < 0 ){   return 0;}
+    return can_dev->mesurables[ops->temp];
 }
 
 
@@ -20,10 +20,23 @@
 
 
 #define N_NODES 4
-#define N_DEVICES 10
+#define N_DEVICES 64
+#define DEV_CTL_INDEX_BITS 7
+#define DEV_CTL_INDEX_SIZE (1U << DEV_CTL_INDEX_BITS)   //hash index buckets, at least 2*N_DEVICES
+#define DEV_CTL_WHEEL_SIZE 256   //liveness timer wheel buckets (ms), power of two
+#define DEV_CTL_ALIVE_TIMEOUT_MS 3000UL   //device is absent when not heard from for this long
+
+//value storage per slot, sized from the drivers. One spare entry each, the DEV_* accessors
+//bound-check with "> enum_end". A paired VG11 holds the setpoints of both modules.
+#define DEV_CTL_GREATER(x, y) (((x) > (y)) ? (x) : (y))
+#define DEV_CTL_MESURABLES (DEV_CTL_GREATER((int) enum_BP25_mesurables_end, \
+        DEV_CTL_GREATER((int) enum_VG11_FM01_mesurables_end, (int) enum_VG11_FM02_mesurables_end)) + 1)
+#define DEV_CTL_SETPOINTS (DEV_CTL_GREATER((int) enum_BP25_setpoints_end, \
+        (int) enum_VG11_FM01_setpoints_end + (int) enum_VG11_FM02_setpoints_end) + 1)
 
 struct can_f;
 struct mal;
+struct ipc_msg;
 
 
 
@@ -68,11 +81,39 @@ enum SETABLE_PARAM {
 };
 
 
+struct can_dev;
+
+
+//Driver functions of a device type, resolved once when the device registers
+struct dev_ops{
+    int mode_end;
+    int setpoints_end;
+    int mesurables_end;
+    int fault_end;
+    int temp;       //mesurable holding the bridge temperature, -1 if none
+
+    const char* (*fault_to_str)(const struct can_dev *can_dev, int fault);
+    bool (*mode_is_supported)(const struct can_dev *can_dev, int mode);
+    const char* (*mode_to_str)(const struct can_dev *can_dev, int mode);
+    const unsigned char* (*mode_to_icon)(const struct can_dev *can_dev, int mode);
+    int (*mesurables_view_param)(const struct can_dev *can_dev, int mesurable, enum VIEW_PARAM param);
+    double (*get_mesurables)(const struct can_dev *can_dev, int mesurable);
+    const char* (*mesurables_to_str)(const struct can_dev *can_dev, int mesurable, enum STRING_PARAM param);
+    const char* (*setpoints_to_str)(const struct can_dev *can_dev, int setpoint, enum STRING_PARAM param);
+    double (*setables_param)(const struct can_dev *can_dev, int setpoint, enum SETABLE_PARAM param);
+    void (*setpoints_check)(const struct can_dev *can_dev, int setpoint, double* value);
+    int (*mode_main_view)(const struct can_dev *can_dev, int mode, int param);
+};
+
+
 
 
 struct can_dev{
     bool present;
-    uint16_t alive_count; 
+    uint32_t alive_deadline;    //dev_ctl timestamp (ms) at which the device is considered absent
+    uint16_t wheel_bucket;
+    uint8_t wheel_next;         //next device in the same wheel bucket, slot + 1
+    bool in_wheel;
     bool compatible;
 
     enum nfo_id id;
@@ -92,7 +133,7 @@ struct can_dev{
     bool ready;
     bool running; 
     int  mode_ctrl;
-    bool faults[32]; //cast to uint_32t to get fault
+    uint32_t faults; //one bit per fault, see DEV_get_fault()/DEV_set_fault()
 
 
     //control
@@ -103,8 +144,8 @@ struct can_dev{
 
  
     //HW specific
-    double mesurables[32]; 
-    double setpoints[16];
+    float mesurables[DEV_CTL_MESURABLES]; 
+    float setpoints[DEV_CTL_SETPOINTS];
     
     //custom view
     int custom_mesurables[4];
@@ -113,6 +154,8 @@ struct can_dev{
     const struct can_dev * paired;  //pointer to paired
     bool paired_slave;
 
+    const struct dev_ops *ops;      //driver functions, NULL until the device registers
+
     bool part_of_ss;
 
 };
@@ -123,21 +166,54 @@ struct can_dev{
 
 struct dev_ctl{
     struct can_dev can_dev[N_DEVICES];
-    uint16_t last_dev_id;
-    uint16_t send_message_to;
-    uint16_t timestamp;
+    uint16_t last_dev_id;       //(stack << 8) | device type of the last frame received
+    uint16_t send_message_to;   //(stack << 8) | device type the databases transmit to, set by can_tx
+    uint32_t timestamp;     //monotonic ms clock, advanced by the control task only
+    uint32_t hw_timestamp;  //hapi_timestamp() at the last whole ms counted into timestamp
+    uint16_t generation;    //bumped whenever a device appears, disappears or moves
+
+    //hash index, slot + 1 per bucket
+    uint8_t index_sn[DEV_CTL_INDEX_SIZE];    //by serial number
+    uint8_t index_dev[DEV_CTL_INDEX_SIZE];   //by (id, stack)
+    uint16_t index_deleted;
+
+    //liveness timer wheel, first device per bucket as slot + 1
+    uint8_t wheel[DEV_CTL_WHEEL_SIZE];
 
 };
 
 struct dev_ctl * dev_ctl_new(const struct tlo *tlo);
 bool dev_ctl_update_devices(const struct tlo *tlo, const struct can_f *f);
+bool dev_ctl_sniffing(const struct tlo *tlo);
 int dev_ctl_find_last_devices(const struct tlo  *tlo, enum nfo_id  exp_id );
+int dev_ctl_find(const struct dev_ctl *self, enum nfo_id id, uint8_t stack);
+int dev_ctl_find_present(const struct dev_ctl *self, enum nfo_id id, uint8_t stack);
+void dev_ctl_remove(struct dev_ctl *self, int i);
+void dev_ctl_bind_ops(struct can_dev *can_dev);
 bool device_is_supported(enum nfo_id  id);
 const char* device_id_to_str(enum nfo_id id);
 
 int change_device_stack( const struct net *net, const struct dev_ctl * self ,  int selected_dev, int new_stack);
 void dev_ctl_update_timestamp(struct dev_ctl *dev_ctl);
 void dev_ctl_check_alive(struct dev_ctl *dev_ctl);
+int dev_ctl_request(struct dev_ctl *self, const struct ipc_msg *msg);
+
+
+//Fault bitmask access
+static inline bool DEV_get_fault(const struct can_dev *can_dev, int fault){
+    return (fault >= 0 && fault < 32) ? (((can_dev->faults >> fault) & 1UL) != 0UL) : false;
+}
+
+static inline void DEV_set_fault(struct can_dev *can_dev, int fault, bool active){
+    if(fault >= 0 && fault < 32){
+        if(active){
+            can_dev->faults |= (1UL << fault);
+        }
+        else{
+            can_dev->faults &= ~(1UL << fault);
+        }
+    }
+}
 
 
 //Generic function
@@ -0,0 +1,132 @@
+/**************************************************************************************************
+ *
+ * \file dev_snap.c
+ *
+ * \brief Device registry snapshot implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/dev_snap.h"
+
+#include "app/ipc_queue.h"
+
+#include "inc/lib/debug.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * \brief Writes one device entry
+ *
+ *************************************************************************************************/
+static void
+dev_snap_write(volatile struct dev_snap_dev *snap, const struct can_dev *can_dev)
+{
+    uint16_t seq = snap->seq;
+
+    snap->seq = seq + 1U;
+    IPC_BARRIER();
+
+    snap->present = can_dev->present;
+    snap->compatible = can_dev->compatible;
+    snap->ready = can_dev->ready;
+    snap->running = can_dev->running;
+    snap->trip_internal = can_dev->trip_internal;
+    snap->trip_external = can_dev->trip_external;
+    snap->id = (uint16_t) can_dev->id;
+    snap->stack = can_dev->stack;
+    snap->mode_ctrl = (int16_t) can_dev->mode_ctrl;
+
+    snap->faults = can_dev->faults;
+
+    uint16_t i;
+    uint16_t n = 0U;
+    if (can_dev->present) {
+        int end = DEV_mesurables_enum_end(can_dev);
+        n = (end < 0) ? 0U : (uint16_t) end;
+        if (n > DEV_SNAP_MESURABLES) {
+            n = DEV_SNAP_MESURABLES;
+        }
+    }
+
+    for (i = 0U; i < n; i++) {
+        snap->mesurables[i] = (float) DEV_get_mesurables(can_dev, i);
+    }
+    snap->n_mesurables = n;
+
+    IPC_BARRIER();
+    snap->seq = seq + 2U;
+}
+
+/**************************************************************************************************
+ *
+ * dev_snap_new()
+ *
+ *************************************************************************************************/
+struct dev_snap *
+dev_snap_new(void)
+{
+    static struct dev_snap dev_snap;
+    memset(&dev_snap, 0u, sizeof(struct dev_snap));
+
+    return &dev_snap;
+}
+
+/**************************************************************************************************
+ *
+ * dev_snap_publish()
+ *
+ *************************************************************************************************/
+void
+dev_snap_publish(struct dev_snap *self, const struct dev_ctl *dev_ctl)
+{
+    ASSERT(self && dev_ctl);
+
+    uint16_t i;
+    for (i = 0U; i < N_DEVICES; i++) {
+        const struct can_dev *can_dev = &dev_ctl->can_dev[i];
+
+        if (can_dev->present || self->dev[i].present) {
+            dev_snap_write(&self->dev[i], can_dev);
+        }
+    }
+
+    IPC_BARRIER();
+    self->generation = dev_ctl->generation;
+}
+
+/**************************************************************************************************
+ *
+ * dev_snap_read()
+ *
+ *************************************************************************************************/
+int
+dev_snap_read(const struct dev_snap *self, uint16_t dev, struct dev_snap_dev *out)
+{
+    if (!self || !out || dev >= N_DEVICES) {
+        return -1;
+    }
+
+    const struct dev_snap_dev *snap = &self->dev[dev];
+
+    uint16_t retry;
+    for (retry = 0U; retry < DEV_SNAP_RETRY; retry++) {
+        uint16_t seq = snap->seq;
+        if (seq & 1U) {
+            continue;
+        }
+
+        IPC_BARRIER();
+        *out = *(volatile const struct dev_snap_dev *) snap;
+        IPC_BARRIER();
+
+        if (snap->seq == seq) {
+            return 0;
+        }
+    }
+
+    return -1;
+}
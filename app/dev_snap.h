@@ -0,0 +1,98 @@
+/**************************************************************************************************
+ *
+ * \file dev_snap.h
+ *
+ * \brief Device registry snapshot interface. The core that owns the registry publishes it, the
+ * user interface reads it without locking (seqlock per device).
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_DEV_SNAP_H
+#define _APP_DEV_SNAP_H
+
+#include "app/dev_ctl.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Mesurables copied per device                                                                  */
+#define DEV_SNAP_MESURABLES (12U)
+
+/** Reader attempts before giving up on a device that is being written                           */
+#define DEV_SNAP_RETRY      (4U)
+
+/**************************************************************************************************
+ *
+ * Device entry. Plain values only, no pointers into the registry.
+ *
+ *************************************************************************************************/
+struct dev_snap_dev {
+    volatile uint16_t seq;          /* Odd while the entry is being written                     */
+    bool present;
+    bool compatible;
+    bool ready;
+    bool running;
+    bool trip_internal;
+    bool trip_external;
+    uint16_t id;                    /* Device type (enum nfo_id)                                */
+    uint16_t stack;
+    int16_t mode_ctrl;
+    uint32_t faults;                /* One bit per fault                                        */
+    uint16_t n_mesurables;          /* Valid entries in mesurables[]                            */
+    float mesurables[DEV_SNAP_MESURABLES];
+};
+
+/**************************************************************************************************
+ *
+ * Device registry snapshot object definition. Written by one core only, so on a dual-core build
+ * it sits in memory owned by that core and the other one only reads it.
+ *
+ *************************************************************************************************/
+struct dev_snap {
+    volatile uint16_t generation;   /* dev_ctl generation at the last publish                   */
+    struct dev_snap_dev dev[N_DEVICES];
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new device registry snapshot object
+ *
+ * \param None
+ *
+ * \return Device registry snapshot object handler
+ *
+ *************************************************************************************************/
+extern struct dev_snap *
+dev_snap_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Copies the registry into the snapshot. Only present devices, and devices that have
+ * just left, are written. Must only be called from the core that owns the registry.
+ *
+ * \param self device registry snapshot object handler
+ * \param dev_ctl device registry
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+dev_snap_publish(struct dev_snap *self, const struct dev_ctl *dev_ctl);
+
+/**************************************************************************************************
+ *
+ * \brief Reads a consistent copy of one device entry
+ *
+ * \param self device registry snapshot object handler
+ * \param dev device registry slot
+ * \param out Pointer to entry buffer
+ *
+ * \return 0 if operation is successful; -1 if the entry kept changing while being read
+ *
+ *************************************************************************************************/
+extern int
+dev_snap_read(const struct dev_snap *self, uint16_t dev, struct dev_snap_dev *out);
+
+#endif /* _APP_DEV_SNAP_H */
@@ -0,0 +1,128 @@
+/**************************************************************************************************
+ *
+ * \file fmt.c
+ *
+ * \brief Fixed-point number formatter implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/fmt.h"
+
+#include <stddef.h>
+
+/** Powers of ten up to FMT_DECIMALS_MAX                                                          */
+static const float fmt_pow10[FMT_DECIMALS_MAX + 1U] = {
+    1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f, 100000.0f, 1000000.0f
+};
+
+/**************************************************************************************************
+ *
+ * \brief Divides by ten with a reciprocal multiply (exact for the whole uint32_t range)
+ *
+ *************************************************************************************************/
+static inline uint32_t
+fmt_div10(uint32_t x)
+{
+    return (uint32_t) (((uint64_t) x * 0xCCCCCCCDULL) >> 35);
+}
+
+/**************************************************************************************************
+ *
+ * fmt_fixed()
+ *
+ *************************************************************************************************/
+uint16_t
+fmt_fixed(char *buf, uint16_t width, int32_t value, uint16_t decimals, const char *unit)
+{
+    char digits[FMT_WIDTH_MAX];
+    uint16_t n = 0U;
+    uint16_t i;
+
+    if (!buf) {
+        return 0U;
+    }
+    if (width > FMT_WIDTH_MAX) {
+        width = FMT_WIDTH_MAX;
+    }
+    if (decimals > FMT_DECIMALS_MAX) {
+        decimals = FMT_DECIMALS_MAX;
+    }
+
+    /* Magnitude without overflow for INT32_MIN */
+    uint32_t mag = (value < 0) ? (uint32_t) (-(value + 1)) + 1UL : (uint32_t) value;
+
+    /* Digits from the least significant one, with at least one digit before the point */
+    uint16_t min = (decimals > 0U) ? decimals + 2U : 1U;
+    do {
+        uint32_t q = fmt_div10(mag);
+        digits[n++] = (char) ('0' + (mag - q * 10UL));
+        mag = q;
+        if (n == decimals) {
+            digits[n++] = '.';
+        }
+    } while (mag != 0UL || n < min);
+
+    if (value < 0) {
+        digits[n++] = '-';
+    }
+
+    uint16_t len = 0U;
+    if (n > width) {
+        for (i = 0U; i < width; i++) {
+            buf[len++] = '#';
+        }
+    } else {
+        for (i = n; i < width; i++) {
+            buf[len++] = ' ';
+        }
+        while (n > 0U) {
+            buf[len++] = digits[--n];
+        }
+    }
+
+    if (unit) {
+        while (*unit) {
+            buf[len++] = *unit++;
+        }
+    }
+    buf[len] = '\0';
+
+    return len;
+}
+
+/**************************************************************************************************
+ *
+ * fmt_scale()
+ *
+ *************************************************************************************************/
+int32_t
+fmt_scale(float value, uint16_t decimals)
+{
+    if (decimals > FMT_DECIMALS_MAX) {
+        decimals = FMT_DECIMALS_MAX;
+    }
+
+    float q = value * fmt_pow10[decimals];
+
+    if (q >= 2147483520.0f) {
+        return INT32_MAX;
+    }
+    if (q <= -2147483520.0f) {
+        return INT32_MIN;
+    }
+
+    return (int32_t) (q < 0.0f ? q - 0.5f : q + 0.5f);
+}
+
+/**************************************************************************************************
+ *
+ * fmt_float()
+ *
+ *************************************************************************************************/
+uint16_t
+fmt_float(char *buf, uint16_t width, float value, uint16_t decimals, const char *unit)
+{
+    return fmt_fixed(buf, width, fmt_scale(value, decimals), decimals, unit);
+}
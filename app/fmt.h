@@ -0,0 +1,69 @@
+/**************************************************************************************************
+ *
+ * \file fmt.h
+ *
+ * \brief Fixed-point number formatter interface. Builds fixed-width decimal strings for the
+ * display with integer multiply and shift only: no division and no printf-family calls.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_FMT_H
+#define _APP_FMT_H
+
+#include <stdint.h>
+
+/** Most digits after the decimal point                                                           */
+#define FMT_DECIMALS_MAX    (6U)
+
+/** Widest number field, enough for any int32_t with sign and decimal point                       */
+#define FMT_WIDTH_MAX       (12U)
+
+/**************************************************************************************************
+ *
+ * \brief Formats a scaled integer. The number is right-aligned in a field of width characters and
+ * the unit is appended right after it. A number that does not fit fills the field with '#'.
+ *
+ * \param buf output buffer, at least width + strlen(unit) + 1 characters
+ * \param width number field width (characters), at most FMT_WIDTH_MAX
+ * \param value value times 10^decimals, e.g. 2301 with 1 decimal is 230.1
+ * \param decimals digits after the decimal point, at most FMT_DECIMALS_MAX
+ * \param unit unit suffix; NULL for none
+ *
+ * \return Length of the string written
+ *
+ *************************************************************************************************/
+extern uint16_t
+fmt_fixed(char *buf, uint16_t width, int32_t value, uint16_t decimals, const char *unit);
+
+/**************************************************************************************************
+ *
+ * \brief Rounds value to the given number of decimals, saturated to the int32_t range
+ *
+ * \param value value
+ * \param decimals digits after the decimal point, at most FMT_DECIMALS_MAX
+ *
+ * \return value times 10^decimals, rounded half away from zero
+ *
+ *************************************************************************************************/
+extern int32_t
+fmt_scale(float value, uint16_t decimals);
+
+/**************************************************************************************************
+ *
+ * \brief Formats a float, same as fmt_fixed(buf, width, fmt_scale(value, decimals), ...)
+ *
+ * \param buf output buffer, at least width + strlen(unit) + 1 characters
+ * \param width number field width (characters), at most FMT_WIDTH_MAX
+ * \param value value
+ * \param decimals digits after the decimal point, at most FMT_DECIMALS_MAX
+ * \param unit unit suffix; NULL for none
+ *
+ * \return Length of the string written
+ *
+ *************************************************************************************************/
+extern uint16_t
+fmt_float(char *buf, uint16_t width, float value, uint16_t decimals, const char *unit);
+
+#endif /* _APP_FMT_H */
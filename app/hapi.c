@@ -295,6 +295,86 @@ int hapi_delay_ms(uint16_t millisec)
 
 
 
+uint32_t hapi_can_objects(void)
+{
+    ASSERT(hapi.can_objects);
+    return hapi.can_objects ? hapi.can_objects() : 0xFFFFFFFFUL;
+}
+
+
+int hapi_can_filter(uint16_t obj, uint32_t id, uint32_t mask, bool last)
+{
+    ASSERT(hapi.can_filter);
+    return hapi.can_filter ? hapi.can_filter(obj, id, mask, last) : -1;
+}
+
+
+int hapi_can_accept_get(uint16_t obj, uint32_t *id, uint32_t *mask)
+{
+    ASSERT(hapi.can_accept_get);
+    return hapi.can_accept_get ? hapi.can_accept_get(obj, id, mask) : -1;
+}
+
+
+int hapi_can_accept_set(uint16_t obj, uint32_t id, uint32_t mask)
+{
+    ASSERT(hapi.can_accept_set);
+    return hapi.can_accept_set ? hapi.can_accept_set(obj, id, mask) : -1;
+}
+
+
+int hapi_can_rx_enable(struct can_rx *can_rx)
+{
+    ASSERT(hapi.can_rx_enable);
+    return hapi.can_rx_enable ? hapi.can_rx_enable(can_rx) : -1;
+}
+
+
+void hapi_can_lock(bool lock)
+{
+    if (hapi.can_lock) {
+        hapi.can_lock(lock);
+    }
+}
+
+
+int hapi_key_irq_enable(struct task_evt *evt)
+{
+    ASSERT(hapi.key_irq_enable);
+    return hapi.key_irq_enable ? hapi.key_irq_enable(evt) : -1;
+}
+
+
+__attribute__((ramfunc)) 
+int hapi_adc_raw(uint16_t *raw)
+{
+    ASSERT(hapi.adc_raw);
+    return hapi.adc_raw ? hapi.adc_raw(raw) : -1;
+}
+
+
+int hapi_adc_dma_enable(struct acq *acq)
+{
+    ASSERT(hapi.adc_dma_enable);
+    return hapi.adc_dma_enable ? hapi.adc_dma_enable(acq) : -1;
+}
+
+
+int hapi_cla_enable(void)
+{
+    ASSERT(hapi.cla_enable);
+    return hapi.cla_enable ? hapi.cla_enable() : -1;
+}
+
+
+__attribute__((ramfunc)) 
+uint32_t hapi_timestamp(void)
+{
+    ASSERT(hapi.timestamp);
+    return hapi.timestamp ? hapi.timestamp() : 0UL;
+}
+
+
 bool hapi_read_interlock(void)
 {
     return hapi.read_interlock();
@@ -372,14 +452,27 @@ void hapi_enable_screen_d_c(bool status)
 }
 
 
-
-
 int hapi_enable_spi_interface(bool enable)
 {
     return hapi.enable_spi_interface(enable);
 }
 
 
+int hapi_screen_write(const uint8_t *data, uint16_t length, bool command)
+{
+    ASSERT(hapi.screen_write);
+    return hapi.screen_write ? hapi.screen_write(data, length, command) : -1;
+}
+
+
+__attribute__((ramfunc)) 
+int hapi_screen_send(const uint8_t *data, uint16_t length, void (*done)(void *ctx), void *ctx)
+{
+    ASSERT(hapi.screen_send);
+    return hapi.screen_send ? hapi.screen_send(data, length, done, ctx) : -1;
+}
+
+
 
 bool hapi_read_button0(void){
       return hapi.read_button0();
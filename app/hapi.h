@@ -19,6 +19,19 @@
 
 #include <stdbool.h>
 
+struct can_rx;
+struct task_evt;
+struct acq;
+
+/** Timestamp counter frequency (free-running CPU timer clocked from SYSCLK)                     */
+#define HAPI_TIMESTAMP_FREQ     (200000000UL)
+
+/** Number of CAN controller message objects                                                    */
+#define HAPI_CAN_OBJECTS        (32U)
+
+/** Longest screen data transfer in bytes (one panel row)                                        */
+#define HAPI_SCREEN_SEND_MAX    (128U)
+
 
 /**************************************************************************************************
  * 
@@ -122,6 +135,19 @@ struct hapi {
 
 
     bool (*read_interlock)(void);
+    uint32_t (*can_objects)(void);
+    int (*can_filter)(uint16_t obj, uint32_t id, uint32_t mask, bool last);
+    int (*can_accept_get)(uint16_t obj, uint32_t *id, uint32_t *mask);
+    int (*can_accept_set)(uint16_t obj, uint32_t id, uint32_t mask);
+    int (*can_rx_enable)(struct can_rx *can_rx);
+    void (*can_lock)(bool lock);
+    int (*key_irq_enable)(struct task_evt *evt);
+    int (*adc_raw)(uint16_t *raw);
+    int (*adc_dma_enable)(struct acq *acq);
+    int (*cla_enable)(void);
+    uint32_t (*timestamp)(void);
+    int (*screen_write)(const uint8_t *data, uint16_t length, bool command);
+    int (*screen_send)(const uint8_t *data, uint16_t length, void (*done)(void *ctx), void *ctx);
     int (*delay)(uint16_t microsec);
     int (*delay_ms)(uint16_t millisec);
 
@@ -150,6 +176,174 @@ extern int hapi_resolve_rev1(struct _hapi *_hapi, unsigned variant);
 extern int hapi_delay(uint16_t microsec);
 extern int hapi_delay_ms(uint16_t millisec);
 
+/**************************************************************************************************
+ * 
+ * \brief Reads which CAN message objects are in use (message valid bits)
+ * 
+ * \return One bit per message object, bit 0 for object 1
+ * 
+ *************************************************************************************************/
+extern uint32_t hapi_can_objects(void);
+
+/**************************************************************************************************
+ * 
+ * \brief Sets up a CAN message object as an application receive object. Frames it accepts raise
+ * the CAN receive interrupt and are pushed into the ring buffer. Consecutive objects with the same
+ * filter form a FIFO, the last one of the FIFO must have last set.
+ * 
+ * \param obj Message object, from 1 to HAPI_CAN_OBJECTS
+ * \param id Extended CAN identifier to match
+ * \param mask Identifier bits that must match
+ * \param last True for the last object of a FIFO, or for a single object
+ * 
+ * \return 0 if operation is successful; -1 otherwise
+ * 
+ *************************************************************************************************/
+extern int hapi_can_filter(uint16_t obj, uint32_t id, uint32_t mask, bool last);
+
+/**************************************************************************************************
+ * 
+ * \brief Reads the acceptance filter of a receive message object
+ * 
+ * \param obj Message object, from 1 to HAPI_CAN_OBJECTS
+ * \param id Pointer to extended CAN identifier to match
+ * \param mask Pointer to identifier bits that must match, all of them if the object has no mask
+ * 
+ * \return 0 if operation is successful; -1 if the object is not a valid receive object
+ * 
+ *************************************************************************************************/
+extern int hapi_can_accept_get(uint16_t obj, uint32_t *id, uint32_t *mask);
+
+/**************************************************************************************************
+ * 
+ * \brief Changes the acceptance filter of a receive message object that uses its mask, e.g. one
+ * set up by fw_lib's init(). Everything else about the object is kept. The object takes no frame
+ * while its filter changes. Must be called with hapi_can_lock() held.
+ * 
+ * \param obj Message object, from 1 to HAPI_CAN_OBJECTS
+ * \param id Extended CAN identifier to match
+ * \param mask Identifier bits that must match
+ * 
+ * \return 0 if operation is successful; -1 if the object is not a valid receive object
+ * 
+ *************************************************************************************************/
+extern int hapi_can_accept_set(uint16_t obj, uint32_t id, uint32_t mask);
+
+/**************************************************************************************************
+ * 
+ * \brief Enables CAN receive interrupt. Frames accepted by the application receive objects are
+ * pushed into the ring buffer together with their receive timestamp.
+ * 
+ * \param can_rx CAN receive ring buffer object handler
+ * 
+ * \return 0 if operation is successful; -1 otherwise
+ * 
+ *************************************************************************************************/
+extern int hapi_can_rx_enable(struct can_rx *can_rx);
+
+/**************************************************************************************************
+ * 
+ * \brief Holds the CAN receive interrupt off while fw_lib talks to the CAN controller. The
+ * interrupt reads message objects through the same interface registers as fw_lib, so every
+ * db_run(), can_write() and can_read() outside of it must be locked.
+ * 
+ * \param lock True to hold the interrupt off; false to let it run again
+ * 
+ * \return None
+ * 
+ *************************************************************************************************/
+extern void hapi_can_lock(bool lock);
+
+/**************************************************************************************************
+ * 
+ * \brief Enables edge interrupts on encoder channel A and on the four front buttons. Every edge
+ * raises TASK_EVT_KEY.
+ * 
+ * \param evt task activation events object handler
+ * 
+ * \return 0 if operation is successful; -1 otherwise
+ * 
+ *************************************************************************************************/
+extern int hapi_key_irq_enable(struct task_evt *evt);
+
+/**************************************************************************************************
+ * 
+ * \brief Copies latest raw ADC results, without filtering or conversion. Called from the ADC
+ * interrupt on every sample.
+ * 
+ * \param raw Result buffer, one element per channel (enum acq_ch)
+ * 
+ * \return 0 if operation is successful; -1 otherwise
+ * 
+ *************************************************************************************************/
+extern int hapi_adc_raw(uint16_t *raw);
+
+/**************************************************************************************************
+ * 
+ * \brief Starts moving ADC results into the acquisition blocks by DMA. The CPU is interrupted
+ * once per block (at half and full buffer) instead of once per sample, and the per-sample ADC
+ * interrupt is switched off.
+ * 
+ * \param acq acquisition object handler
+ * 
+ * \return 0 if operation is successful; -1 if DMA is not available
+ * 
+ *************************************************************************************************/
+extern int hapi_adc_dma_enable(struct acq *acq);
+
+/**************************************************************************************************
+ * 
+ * \brief Starts ADC acquisition and filtering on the CLA (CLA_OFFLOAD builds). The CLA reads the
+ * results on every sample, neither the CPU nor the DMA is involved.
+ * 
+ * \return 0 if operation is successful; -1 if the CLA is not available
+ * 
+ *************************************************************************************************/
+extern int hapi_cla_enable(void);
+
+/**************************************************************************************************
+ * 
+ * \brief Reads free-running timestamp counter. Counter runs at HAPI_TIMESTAMP_FREQ and wraps
+ * around, so only differences between two timestamps are meaningful.
+ * 
+ * \return Timestamp
+ * 
+ *************************************************************************************************/
+extern uint32_t hapi_timestamp(void);
+
+/**************************************************************************************************
+ * 
+ * \brief Writes bytes to the display controller over SPI. Waits for the bytes of the previous
+ * write to shift out before switching the D/C line, but not for a transfer started by
+ * hapi_screen_send().
+ * 
+ * \param data Bytes to write, one per array element
+ * \param length Number of bytes
+ * \param command True to write command bytes (D/C low); false to write data bytes
+ * 
+ * \return 0 if operation is successful; -1 if a transfer is in progress or SPI is not open
+ * 
+ *************************************************************************************************/
+extern int hapi_screen_write(const uint8_t *data, uint16_t length, bool command);
+
+/**************************************************************************************************
+ * 
+ * \brief Starts sending data bytes to the display controller by DMA and returns right away. D/C
+ * is raised once the previous command bytes have shifted out. The data is copied, so the buffer
+ * may change as soon as this returns.
+ * 
+ * \param data Bytes to write, one per array element
+ * \param length Number of bytes, at most HAPI_SCREEN_SEND_MAX
+ * \param done Called from the SPI interrupt once the transmit FIFO has drained; may start the
+ * next transfer
+ * \param ctx Argument passed to done
+ * 
+ * \return 0 if transfer was started; -1 if a transfer is in progress or DMA is not available
+ * 
+ *************************************************************************************************/
+extern int hapi_screen_send(const uint8_t *data, uint16_t length, void (*done)(void *ctx),
+    void *ctx);
+
 extern void hapi_toggle_led_1(void);
 extern void hapi_toggle_led_2(void);
 extern void hapi_enable_led_2(bool status);
@@ -13,6 +13,13 @@
 #include "app/adc.h"
 #include "app/ctl.h"
 #include "app/wcs.h"
+#include "app/can_rx.h"
+#include "app/task_evt.h"
+#include "app/acq.h"
+
+#if defined(CLA_OFFLOAD)
+#include "app/acq_cla.h"
+#endif
 
 #include "inc/drv/pie.h"
 #include "inc/drv/pwm.h"
@@ -52,6 +59,34 @@ static int
 _hapi_enable_spi_interface(bool enable);
 static void
 _hapi_enable_screen_d_c(bool status);
+static int
+_hapi_screen_write(const uint8_t *data, uint16_t length, bool command);
+static int
+_hapi_screen_send(const uint8_t *data, uint16_t length, void (*done)(void *ctx), void *ctx);
+static uint32_t
+_hapi_can_objects(void);
+static int
+_hapi_can_filter(uint16_t obj, uint32_t id, uint32_t mask, bool last);
+static int
+_hapi_can_accept_get(uint16_t obj, uint32_t *id, uint32_t *mask);
+static int
+_hapi_can_accept_set(uint16_t obj, uint32_t id, uint32_t mask);
+static int
+_hapi_can_rx_enable(struct can_rx *can_rx);
+static void
+_hapi_can_lock(bool lock);
+static int
+_hapi_key_irq_enable(struct task_evt *evt);
+static int
+_hapi_adc_raw(uint16_t *raw);
+static int
+_hapi_adc_dma_enable(struct acq *acq);
+#if defined(CLA_OFFLOAD)
+static int
+_hapi_cla_enable(void);
+#endif
+static uint32_t
+_hapi_timestamp(void);
 
 static bool _hapi_read_button0(void);
 static bool _hapi_read_button1(void);
@@ -75,6 +110,86 @@ static void  _hapi_enable_led_b3_g(bool status);
 
 static struct hapi *hapi = NULL;
 
+/**************************************************************************************************
+ * 
+ * CAN receive ring buffer filled from the CAN receive interrupt
+ * 
+ *************************************************************************************************/
+
+static struct can_rx *can_rx = NULL;
+
+/** Message objects set up by _hapi_can_filter(), bit 0 for object 1. fw_lib owns all others.    */
+static uint32_t can_app_objs = 0UL;
+
+/**************************************************************************************************
+ * 
+ * Events raised by the key edge interrupts. The device has five external interrupt lines: one
+ * for encoder channel A and one per front button. GPIO numbers follow map.coding_a and
+ * map.button0..3. Encoder channel B is read by the key job, which runs at 1 kHz after every
+ * edge, and button_cw (GPIO100) is sampled at the key fallback rate.
+ * 
+ *************************************************************************************************/
+
+static const struct {
+    uint32_t gpio;
+    GPIO_ExternalIntNum xint;
+} hapi_key_xint[] = {
+    { 10U, GPIO_INT_XINT1 },        /* coding_a                                                 */
+    { 15U, GPIO_INT_XINT2 },        /* button0                                                  */
+    { 14U, GPIO_INT_XINT3 },        /* button1                                                  */
+    { 13U, GPIO_INT_XINT4 },        /* button2                                                  */
+    { 12U, GPIO_INT_XINT5 },        /* button3                                                  */
+};
+
+#define HAPI_KEY_XINTS          (sizeof(hapi_key_xint) / sizeof(hapi_key_xint[0]))
+
+static struct task_evt *key_evt = NULL;
+
+/**************************************************************************************************
+ * 
+ * ADC result capture by DMA. One channel per ADC module moves the results of that module's SOCs
+ * (see _ADC_VAR_INIT()) into the acquisition block, interleaved by channel (enum acq_ch).
+ * 
+ *************************************************************************************************/
+
+struct hapi_adc_dma {
+    uint32_t dma;                   /* DMA channel                                              */
+    uint32_t result;                /* First result register                                    */
+    uint16_t burst;                 /* Consecutive result registers (SOCs)                      */
+    uint16_t ch;                    /* First acquisition channel                                */
+};
+
+static const struct hapi_adc_dma hapi_adc_dma[] = {
+    { DMA_CH1_BASE, ADCCRESULT_BASE + ADC_O_RESULT0, 2U, ACQ_BUTTON0   },
+    { DMA_CH2_BASE, ADCARESULT_BASE + ADC_O_RESULT2, 2U, ACQ_BUTTON2   },
+    { DMA_CH3_BASE, ADCBRESULT_BASE + ADC_O_RESULT4, 1U, ACQ_BUTTON_CW },
+};
+
+#define HAPI_ADC_DMA_N      (sizeof(hapi_adc_dma) / sizeof(hapi_adc_dma[0]))
+
+static struct acq *adc_acq = NULL;
+
+/**************************************************************************************************
+ * 
+ * Screen data transfer by DMA. Bytes are staged left-justified, the DMA tops the SPI transmit
+ * FIFO up one word at a time. Once the DMA is done, the transmit FIFO interrupt at level 0
+ * completes the transfer when the FIFO has drained, so neither interrupt waits on the SPI.
+ * 
+ *************************************************************************************************/
+
+#define HAPI_SCREEN_DMA         (DMA_CH6_BASE)
+#define HAPI_SCREEN_FIFO_LEVEL  (SPI_FIFO_TX2)
+
+/** SSD1322 power-on sequence: RES# low for at least 100 us, same again before the first command */
+#define HAPI_SCREEN_RST_US      (100U)
+
+static uint16_t screen_tx[HAPI_SCREEN_SEND_MAX];
+static void (*screen_done)(void *ctx) = NULL;
+static void *screen_ctx = NULL;
+static volatile bool screen_dma_busy = false;
+static bool screen_dma_ready = false;
+static bool screen_data = false;        /* D/C is high, the data phase is going on              */
+
 /**************************************************************************************************
  * 
  * hapi_resolve_rev0()
@@ -140,8 +255,23 @@ hapi_resolve_rev0(struct _hapi *_hapi, unsigned variant)
     hapi->read_coding_a = _hapi_read_coding_a;
     hapi->read_coding_b = _hapi_read_coding_b;
     hapi->read_interlock = _hapi_read_interlock;
+    hapi->can_objects = _hapi_can_objects;
+    hapi->can_filter = _hapi_can_filter;
+    hapi->can_accept_get = _hapi_can_accept_get;
+    hapi->can_accept_set = _hapi_can_accept_set;
+    hapi->can_rx_enable = _hapi_can_rx_enable;
+    hapi->can_lock = _hapi_can_lock;
+    hapi->key_irq_enable = _hapi_key_irq_enable;
+    hapi->adc_raw = _hapi_adc_raw;
+    hapi->adc_dma_enable = _hapi_adc_dma_enable;
+#if defined(CLA_OFFLOAD)
+    hapi->cla_enable = _hapi_cla_enable;
+#endif
+    hapi->timestamp = _hapi_timestamp;
 
     hapi->enable_spi_interface = _hapi_enable_spi_interface;
+    hapi->screen_write = _hapi_screen_write;
+    hapi->screen_send = _hapi_screen_send;
 
     hapi->read_button0 =   _hapi_read_button0;
     hapi->read_button1 =   _hapi_read_button1;
@@ -193,6 +323,18 @@ _hapi_setup(void)
 
     pwm_trigger(EPWM1_BASE, EPWM_SOC_A, EPWM_SOC_TBCTR_ZERO, C_ISR_DIVIDER);
 
+    /* DMA channels are shared by ADC capture and screen transfers, reset once here */
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_DMA);
+    SysCtl_selectSecController(SYSCTL_SEC_CONTROLLER_FRAME2, SYSCTL_SEC_CONTROLLER_DMA);
+    DMA_initController();
+
+    /* Free-running timestamp counter */
+    CPUTimer_stopTimer(CPUTIMER2_BASE);
+    CPUTimer_setPeriod(CPUTIMER2_BASE, 0xFFFFFFFFUL);
+    CPUTimer_setPreScaler(CPUTIMER2_BASE, 0U);
+    CPUTimer_reloadTimerCounter(CPUTIMER2_BASE);
+    CPUTimer_startTimer(CPUTIMER2_BASE);
+
      pie_register(INT_ADCA1, hapi_isr_run);
 
 
@@ -252,6 +394,24 @@ _hapi_adc_read(const struct adc *adc)
     return 0;
 }
 
+/**************************************************************************************************
+ * 
+ * _hapi_adc_raw()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static int
+_hapi_adc_raw(uint16_t *raw)
+{
+    /* Result registers and SOC numbers follow _ADC_VAR_INIT() (module 1..3 is ADC A..C) */
+    raw[ACQ_BUTTON0]   = ADC_readResult(ADCCRESULT_BASE, ADC_SOC_NUMBER0);
+    raw[ACQ_BUTTON1]   = ADC_readResult(ADCCRESULT_BASE, ADC_SOC_NUMBER1);
+    raw[ACQ_BUTTON2]   = ADC_readResult(ADCARESULT_BASE, ADC_SOC_NUMBER2);
+    raw[ACQ_BUTTON3]   = ADC_readResult(ADCARESULT_BASE, ADC_SOC_NUMBER3);
+    raw[ACQ_BUTTON_CW] = ADC_readResult(ADCBRESULT_BASE, ADC_SOC_NUMBER4);
+
+    return 0;
+}
+
 /**************************************************************************************************
  * 
  * _hapi_adc_read()
@@ -351,11 +511,13 @@ void _hapi_enable_led_b3_g(bool status)
 void _hapi_enable_screen_d_c(bool status)
 {    
     dio_write(hapi->map->screen_d_c,status);
+    screen_data = status;
 }
 
 
 
 
+
 bool _hapi_read_button0(void)
 {   
     bool state;
@@ -425,6 +587,86 @@ bool _hapi_read_interlock(void)
 }
 
 
+/**************************************************************************************************
+ * 
+ * _hapi_screen_idle()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static void
+_hapi_screen_idle(void)
+{
+    while (SPI_getTxFIFOStatus(SPIA_BASE) != SPI_FIFO_TXEMPTY || SPI_isBusy(SPIA_BASE)) {
+    }
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_screen_dma_isr()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static __interrupt void
+_hapi_screen_dma_isr(void)
+{
+    /* Last word was handed to the FIFO, the transfer completes once the FIFO has drained */
+    SPI_setFIFOInterruptLevel(SPIA_BASE, SPI_FIFO_TXEMPTY, SPI_FIFO_RX16);
+    SPI_clearInterruptStatus(SPIA_BASE, SPI_INT_TXFF);
+    SPI_enableInterrupt(SPIA_BASE, SPI_INT_TXFF);
+
+    pie_clear(INT_DMA_CH6);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_screen_spi_isr()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static __interrupt void
+_hapi_screen_spi_isr(void)
+{
+    /* FIFO is empty, only the character in the shift register is left to go out */
+    SPI_disableInterrupt(SPIA_BASE, SPI_INT_TXFF);
+    SPI_clearInterruptStatus(SPIA_BASE, SPI_INT_TXFF);
+    screen_dma_busy = false;
+
+    /* Callback may start the next transfer right away, D/C stays high */
+    if (screen_done) {
+        screen_done(screen_ctx);
+    }
+
+    pie_clear(INT_SPIA_TX);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_screen_dma_setup()
+ * 
+ *************************************************************************************************/
+static void
+_hapi_screen_dma_setup(void)
+{
+    /* Set up on first use, the display library's own transfers run without the FIFO */
+    if (screen_dma_ready) {
+        return;
+    }
+    screen_dma_ready = true;
+
+    /* DMA is triggered while the FIFO holds HAPI_SCREEN_FIFO_LEVEL characters or fewer */
+    SPI_enableFIFO(SPIA_BASE);
+    SPI_setFIFOInterruptLevel(SPIA_BASE, HAPI_SCREEN_FIFO_LEVEL, SPI_FIFO_RX16);
+
+    pie_register(INT_DMA_CH6, _hapi_screen_dma_isr);
+    pie_register(INT_SPIA_TX, _hapi_screen_spi_isr);
+
+    DMA_configBurst(HAPI_SCREEN_DMA, 1U, 0, 0);
+    DMA_configWrap(HAPI_SCREEN_DMA, 0x10000UL, 0, 0x10000UL, 0);
+    DMA_configMode(HAPI_SCREEN_DMA, DMA_TRIGGER_SPIATX,
+        DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_DISABLE | DMA_CFG_SIZE_16BIT);
+    DMA_setInterruptMode(HAPI_SCREEN_DMA, DMA_INT_AT_END);
+    DMA_clearTriggerFlag(HAPI_SCREEN_DMA);
+    DMA_enableInterrupt(HAPI_SCREEN_DMA);
+    DMA_enableTrigger(HAPI_SCREEN_DMA);
+}
+
 int _hapi_enable_spi_interface(bool enable)
 {
  
@@ -474,9 +716,9 @@ int _hapi_enable_spi_interface(bool enable)
 
 
         dio_write(hapi->map->screen_rst_n, false); //0
-        hapi_delay_ms(500);   
+        hapi_delay(HAPI_SCREEN_RST_US);
         dio_write(hapi->map->screen_rst_n, true); //1
-        hapi_delay_ms(500);
+        hapi_delay(HAPI_SCREEN_RST_US);
         has_been_set = 1;
 
 
@@ -492,3 +734,492 @@ int _hapi_enable_spi_interface(bool enable)
 
 }
 
+/**************************************************************************************************
+ * 
+ * _hapi_screen_write()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_screen_write(const uint8_t *data, uint16_t length, bool command)
+{
+    if (!data || !hapi->spi_net) {
+        return -1;
+    }
+
+    _hapi_screen_dma_setup();
+
+    /* A data transfer in progress is not waited for, the caller tries again later */
+    if (screen_dma_busy) {
+        return -1;
+    }
+
+    /* D/C may only change when SPI is idle: at most the bytes of the previous write are left */
+    _hapi_screen_idle();
+    dio_write(hapi->map->screen_d_c, !command);
+    screen_data = !command;
+
+    uint16_t i;
+    for (i = 0U; i < length; i++) {
+        /* 8-bit characters are left-justified in the transmit buffer */
+        SPI_writeDataBlockingFIFO(SPIA_BASE, (uint16_t) ((data[i] & 0xFFU) << 8));
+    }
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_screen_send()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static int
+_hapi_screen_send(const uint8_t *data, uint16_t length, void (*done)(void *ctx), void *ctx)
+{
+    if (!data || length == 0U || length > HAPI_SCREEN_SEND_MAX || !hapi->spi_net ||
+        screen_dma_busy) {
+        return -1;
+    }
+
+    _hapi_screen_dma_setup();
+
+    uint16_t i;
+    for (i = 0U; i < length; i++) {
+        screen_tx[i] = (uint16_t) ((data[i] & 0xFFU) << 8);
+    }
+
+    /* Data phase, the last command bit must have left before D/C goes high. Rows chained from
+     * the completion interrupt are already in the data phase and do not wait. */
+    if (!screen_data) {
+        _hapi_screen_idle();
+        dio_write(hapi->map->screen_d_c, true);
+        screen_data = true;
+    }
+
+    screen_done = done;
+    screen_ctx = ctx;
+    screen_dma_busy = true;
+
+    /* DMA is triggered again while the FIFO holds HAPI_SCREEN_FIFO_LEVEL characters or fewer */
+    SPI_setFIFOInterruptLevel(SPIA_BASE, HAPI_SCREEN_FIFO_LEVEL, SPI_FIFO_RX16);
+
+    DMA_configAddresses(HAPI_SCREEN_DMA, (const void *) (SPIA_BASE + SPI_O_TXBUF), screen_tx);
+    DMA_configTransfer(HAPI_SCREEN_DMA, length, 1, 0);
+    DMA_startChannel(HAPI_SCREEN_DMA);
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_can_objects()
+ * 
+ *************************************************************************************************/
+static uint32_t
+_hapi_can_objects(void)
+{
+    return HWREG_BP(CANA_BASE + CAN_O_MVAL_21);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_can_filter()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_can_filter(uint16_t obj, uint32_t id, uint32_t mask, bool last)
+{
+    if (obj < 1U || obj > HAPI_CAN_OBJECTS) {
+        return -1;
+    }
+
+    /* Objects of a FIFO but the last one have EoB cleared, so a full object passes frames on */
+    uint32_t flags = CAN_MSG_OBJ_USE_ID_FILTER | CAN_MSG_OBJ_USE_EXT_FILTER |
+        CAN_MSG_OBJ_RX_INT_ENABLE;
+    if (!last) {
+        flags |= CAN_MSG_OBJ_FIFO;
+    }
+
+    CAN_setupMessageObject(CANA_BASE, obj, id, CAN_MSG_FRAME_EXT, CAN_MSG_OBJ_TYPE_RX, mask,
+        flags, 8U);
+
+    can_app_objs |= 1UL << (obj - 1U);
+
+    return 0;
+}
+
+
+/**************************************************************************************************
+ * 
+ * \brief Moves a message object to or from the interface 1 registers. The receive interrupt
+ * uses interface 2, fw_lib is kept out by hapi_can_lock().
+ * 
+ * \param obj Message object, from 1 to HAPI_CAN_OBJECTS
+ * \param cmd CAN_IF1CMD_* bits: direction and the parts of the object to move
+ * 
+ * \return None
+ * 
+ *************************************************************************************************/
+static void
+_hapi_can_if1(uint16_t obj, uint32_t cmd)
+{
+    HWREG_BP(CANA_BASE + CAN_O_IF1CMD) = cmd | ((uint32_t) obj & CAN_IF1CMD_MSG_NUM_M);
+
+    /* A transfer takes a few CAN clock cycles */
+    while (HWREGH(CANA_BASE + CAN_O_IF1CMD) & CAN_IF1CMD_BUSY) {
+    }
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_can_accept_get()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_can_accept_get(uint16_t obj, uint32_t *id, uint32_t *mask)
+{
+    if (obj < 1U || obj > HAPI_CAN_OBJECTS || !id || !mask) {
+        return -1;
+    }
+
+    _hapi_can_if1(obj, CAN_IF1CMD_ARB | CAN_IF1CMD_MASK | CAN_IF1CMD_CONTROL);
+
+    uint32_t arb = HWREG_BP(CANA_BASE + CAN_O_IF1ARB);
+    if (!(arb & CAN_IF1ARB_MSGVAL) || (arb & CAN_IF1ARB_DIR)) {
+        return -1;
+    }
+
+    *id = arb & CAN_IF1ARB_ID_M;
+    *mask = (HWREG_BP(CANA_BASE + CAN_O_IF1MCTL) & CAN_IF1MCTL_UMASK) ?
+        (HWREG_BP(CANA_BASE + CAN_O_IF1MSK) & CAN_IF1MSK_MSK_M) : CAN_IF1MSK_MSK_M;
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_can_accept_set()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_can_accept_set(uint16_t obj, uint32_t id, uint32_t mask)
+{
+    if (obj < 1U || obj > HAPI_CAN_OBJECTS) {
+        return -1;
+    }
+
+    _hapi_can_if1(obj, CAN_IF1CMD_ARB | CAN_IF1CMD_MASK | CAN_IF1CMD_CONTROL);
+
+    uint32_t arb = HWREG_BP(CANA_BASE + CAN_O_IF1ARB);
+    if (!(arb & CAN_IF1ARB_MSGVAL) || (arb & CAN_IF1ARB_DIR) ||
+        !(HWREG_BP(CANA_BASE + CAN_O_IF1MCTL) & CAN_IF1MCTL_UMASK)) {
+        return -1;
+    }
+
+    /**
+     * Arbitration and mask may only change while the object is not valid. Control bits are not
+     * written back, so a frame the object holds stays there for fw_lib to read.
+     */
+    HWREG_BP(CANA_BASE + CAN_O_IF1ARB) = arb & ~CAN_IF1ARB_MSGVAL;
+    _hapi_can_if1(obj, CAN_IF1CMD_DIR | CAN_IF1CMD_ARB);
+
+    uint32_t msk = HWREG_BP(CANA_BASE + CAN_O_IF1MSK);
+    HWREG_BP(CANA_BASE + CAN_O_IF1MSK) = (msk & ~CAN_IF1MSK_MSK_M) | (mask & CAN_IF1MSK_MSK_M);
+    HWREG_BP(CANA_BASE + CAN_O_IF1ARB) = (arb & ~CAN_IF1ARB_ID_M) | (id & CAN_IF1ARB_ID_M);
+    _hapi_can_if1(obj, CAN_IF1CMD_DIR | CAN_IF1CMD_ARB | CAN_IF1CMD_MASK);
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_can_rx_isr()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static __interrupt void
+_hapi_can_rx_isr(void)
+{
+    uint32_t timestamp = _hapi_timestamp();
+    uint32_t obj;
+    uint16_t n;
+
+    /**
+     * Interrupt cause is the status interrupt or the lowest message object with a pending
+     * interrupt. Every cause is cleared, otherwise it would fire again right away.
+     */
+    for (n = 0U; n <= HAPI_CAN_OBJECTS && (obj = CAN_getInterruptCause(CANA_BASE)) != 0UL; n++) {
+        if (obj == CAN_INT_INT0ID_STATUS) {
+            /* Bus-off, error passive, ...: reading the status register clears it */
+            (void) CAN_getStatus(CANA_BASE);
+            continue;
+        }
+
+        if (obj > HAPI_CAN_OBJECTS || !(can_app_objs & (1UL << (obj - 1UL)))) {
+            /* Not an application object: its frame stays there for fw_lib to poll */
+            CAN_clearInterruptStatus(CANA_BASE, obj);
+            continue;
+        }
+
+        struct can_f f;
+        CAN_MsgFrameType type;
+        uint16_t data[8];
+
+        CAN_readMessageWithID(CANA_BASE, obj, &type, &f.id, data);
+        CAN_clearInterruptStatus(CANA_BASE, obj);
+
+        f.length = HWREGH(CANA_BASE + CAN_O_IF2MCTL) & CAN_IF2MCTL_DLC_M;
+
+        uint16_t i;
+        for (i = 0U; i < 8U; i++) {
+            f.data[i] = data[i] & 0xFFU;
+        }
+
+        if (can_rx) {
+            can_rx_push(can_rx, &f, timestamp);
+        }
+    }
+
+    CAN_clearGlobalInterruptStatus(CANA_BASE, CAN_GLOBAL_INT_CANINT0);
+    pie_clear(INT_CANA0);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_can_rx_enable()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_can_rx_enable(struct can_rx *_can_rx)
+{
+    if (!_can_rx) {
+        return -1;
+    }
+
+    can_rx = _can_rx;
+
+    pie_register(INT_CANA0, _hapi_can_rx_isr);
+
+    /**
+     * Error interrupts only: status change interrupts would also fire on every frame sent or
+     * received. Frames the application objects took before now are pending and are read as
+     * soon as the interrupt is enabled.
+     */
+    CAN_enableInterrupt(CANA_BASE, CAN_INT_IE0 | CAN_INT_ERROR);
+    CAN_enableGlobalInterrupt(CANA_BASE, CAN_GLOBAL_INT_CANINT0);
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_can_lock()
+ * 
+ *************************************************************************************************/
+static void
+_hapi_can_lock(bool lock)
+{
+    /* Receive interrupt is only registered once enabled */
+    if (!can_rx) {
+        return;
+    }
+
+    if (lock) {
+        Interrupt_disable(INT_CANA0);
+    } else {
+        Interrupt_enable(INT_CANA0);
+    }
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_key_isr()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static __interrupt void
+_hapi_key_isr(void)
+{
+    task_evt_set(key_evt, TASK_EVT_KEY);
+
+    /* XINT1 and XINT2 share PIE group 1 */
+    pie_clear(INT_XINT1);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_key_isr_g12()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static __interrupt void
+_hapi_key_isr_g12(void)
+{
+    task_evt_set(key_evt, TASK_EVT_KEY);
+
+    /* XINT3 to XINT5 share PIE group 12 */
+    pie_clear(INT_XINT3);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_key_irq_enable()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_key_irq_enable(struct task_evt *evt)
+{
+    if (!evt) {
+        return -1;
+    }
+
+    key_evt = evt;
+
+    pie_register(INT_XINT1, _hapi_key_isr);
+    pie_register(INT_XINT2, _hapi_key_isr);
+    pie_register(INT_XINT3, _hapi_key_isr_g12);
+    pie_register(INT_XINT4, _hapi_key_isr_g12);
+    pie_register(INT_XINT5, _hapi_key_isr_g12);
+
+    /* Both edges: the encoder moves on either, a button is reported on press and on release */
+    uint16_t i;
+    for (i = 0U; i < HAPI_KEY_XINTS; i++) {
+        GPIO_setInterruptPin(hapi_key_xint[i].gpio, hapi_key_xint[i].xint);
+        GPIO_setInterruptType(hapi_key_xint[i].xint, GPIO_INT_TYPE_BOTH_EDGES);
+        GPIO_enableInterrupt(hapi_key_xint[i].xint);
+    }
+
+    return 0;
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_adc_int2()
+ * 
+ *************************************************************************************************/
+static void
+_hapi_adc_int2(void)
+{
+    /**
+     * ADCINT2 fires on the last ADC A conversion, which ends together with the last ADC C one.
+     * Continuous mode keeps it firing without the flag being cleared, and ADCINT1 is switched
+     * off so the CPU is no longer interrupted per sample.
+     */
+    ADC_setInterruptSource(ADCA_BASE, ADC_INT_NUMBER2, ADC_SOC_NUMBER3);
+    ADC_enableContinuousMode(ADCA_BASE, ADC_INT_NUMBER2);
+    ADC_enableInterrupt(ADCA_BASE, ADC_INT_NUMBER2);
+    ADC_disableInterrupt(ADCA_BASE, ADC_INT_NUMBER1);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_adc_dma_isr()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static __interrupt void
+_hapi_adc_dma_isr(void)
+{
+    /**
+     * Last channel finished the half, so all of them did. Shadow addresses are loaded at the
+     * start of the next transfer, one sample period from now.
+     */
+    uint16_t *row = acq_commit(adc_acq);
+
+    uint16_t i;
+    for (i = 0U; i < HAPI_ADC_DMA_N; i++) {
+        DMA_configDestAddress(hapi_adc_dma[i].dma, &row[hapi_adc_dma[i].ch]);
+    }
+
+    pie_clear(INT_DMA_CH3);
+}
+
+/**************************************************************************************************
+ * 
+ * _hapi_adc_dma_enable()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_adc_dma_enable(struct acq *acq)
+{
+    if (!acq) {
+        return -1;
+    }
+
+    adc_acq = acq;
+
+    pie_register(INT_DMA_CH3, _hapi_adc_dma_isr);
+
+    uint16_t i;
+    for (i = 0U; i < HAPI_ADC_DMA_N; i++) {
+        const struct hapi_adc_dma *d = &hapi_adc_dma[i];
+        int16_t burst = (int16_t) d->burst;
+
+        DMA_configAddresses(d->dma, &acq->block[0].raw[0][d->ch], (const void *) d->result);
+
+        /* One burst per sample, then back to the first result and on to the next row */
+        DMA_configBurst(d->dma, d->burst, 1, 1);
+        DMA_configTransfer(d->dma, ACQ_BLOCK, 1 - burst, (int16_t) ACQ_CH_N - (burst - 1));
+        DMA_configWrap(d->dma, 0x10000UL, 0, 0x10000UL, 0);
+
+        DMA_configMode(d->dma, DMA_TRIGGER_ADCA2,
+            DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_ENABLE | DMA_CFG_SIZE_16BIT);
+
+        DMA_clearTriggerFlag(d->dma);
+        DMA_clearErrorFlag(d->dma);
+        DMA_enableTrigger(d->dma);
+    }
+
+    /* Channels are served in order, the last one marks the end of a half */
+    DMA_setInterruptMode(DMA_CH3_BASE, DMA_INT_AT_END);
+    DMA_enableInterrupt(DMA_CH3_BASE);
+
+    for (i = 0U; i < HAPI_ADC_DMA_N; i++) {
+        DMA_startChannel(hapi_adc_dma[i].dma);
+    }
+
+    _hapi_adc_int2();
+
+    return 0;
+}
+
+#if defined(CLA_OFFLOAD)
+/**************************************************************************************************
+ * 
+ * _hapi_cla_enable()
+ * 
+ *************************************************************************************************/
+static int
+_hapi_cla_enable(void)
+{
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_CLA1);
+
+    /* CLA program and data sections are placed in LS0..LS1 by the linker command file */
+    MemCfg_setLSRAMControllerSel(MEMCFG_SECT_LS0, MEMCFG_LSRAMCONTROLLER_CPU_CLA1);
+    MemCfg_setLSRAMControllerSel(MEMCFG_SECT_LS1, MEMCFG_LSRAMCONTROLLER_CPU_CLA1);
+    MemCfg_setCLAMemType(MEMCFG_SECT_LS0, MEMCFG_CLA_MEM_PROGRAM);
+    MemCfg_setCLAMemType(MEMCFG_SECT_LS1, MEMCFG_CLA_MEM_DATA);
+
+    CLA_mapTaskVector(CLA1_BASE, CLA_MVECT_1, (uint16_t) &Cla1Task1);
+    CLA_mapTaskVector(CLA1_BASE, CLA_MVECT_8, (uint16_t) &Cla1Task8);
+    CLA_setTriggerSource(CLA_TASK_1, CLA_TRIGGER_ADCA2);
+    CLA_enableIACK(CLA1_BASE);
+    CLA_enableTasks(CLA1_BASE, CLA_TASKFLAG_1 | CLA_TASKFLAG_8);
+
+    /* Message RAM is cleared before the first sample is taken */
+    CLA_forceTasks(CLA1_BASE, CLA_TASKFLAG_8);
+    while (CLA_getTaskRunStatus(CLA1_BASE, CLA_TASK_8)) {
+    }
+
+    _hapi_adc_int2();
+
+    return 0;
+}
+#endif
+
+/**************************************************************************************************
+ * 
+ * _hapi_timestamp()
+ * 
+ *************************************************************************************************/
+__attribute__((ramfunc)) static uint32_t
+_hapi_timestamp(void)
+{
+    /* CPU timer counts down, flip it to get an up-counter */
+    return 0xFFFFFFFFUL - CPUTimer_getTimerCount(CPUTIMER2_BASE);
+}
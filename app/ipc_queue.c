@@ -0,0 +1,92 @@
+/**************************************************************************************************
+ *
+ * \file ipc_queue.c
+ *
+ * \brief Inter-core message queue implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/ipc_queue.h"
+
+#include "inc/lib/debug.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * ipc_queue_new()
+ *
+ *************************************************************************************************/
+struct ipc_queue *
+ipc_queue_new(void)
+{
+    static struct ipc_queue_tx tx;
+    memset(&tx, 0u, sizeof(struct ipc_queue_tx));
+
+    static struct ipc_queue_rx rx;
+    memset(&rx, 0u, sizeof(struct ipc_queue_rx));
+
+    static struct ipc_queue ipc_queue;
+    memset(&ipc_queue, 0u, sizeof(struct ipc_queue));
+
+    ipc_queue.tx = &tx;
+    ipc_queue.rx = &rx;
+
+    return &ipc_queue;
+}
+
+/**************************************************************************************************
+ *
+ * ipc_queue_push()
+ *
+ *************************************************************************************************/
+bool
+ipc_queue_push(struct ipc_queue *self, const struct ipc_msg *msg)
+{
+    ASSERT(self && msg);
+
+    uint16_t head = self->tx->head;
+
+    if ((uint16_t) (head - self->rx->tail) >= IPC_QUEUE_SIZE) {
+        self->dropped++;
+        return false;
+    }
+
+    volatile struct ipc_msg *slot = &self->tx->msg[head & (IPC_QUEUE_SIZE - 1U)];
+    *slot = *msg;
+
+    /* Message must be in place before the consumer can see it */
+    IPC_BARRIER();
+    self->tx->head = head + 1U;
+
+    return true;
+}
+
+/**************************************************************************************************
+ *
+ * ipc_queue_pop()
+ *
+ *************************************************************************************************/
+bool
+ipc_queue_pop(struct ipc_queue *self, struct ipc_msg *msg)
+{
+    ASSERT(self && msg);
+
+    uint16_t tail = self->rx->tail;
+
+    if (tail == self->tx->head) {
+        return false;
+    }
+
+    IPC_BARRIER();
+    *msg = *(volatile const struct ipc_msg *) &self->tx->msg[tail & (IPC_QUEUE_SIZE - 1U)];
+
+    /* Slot is free for the producer only once it has been copied */
+    IPC_BARRIER();
+    self->rx->tail = tail + 1U;
+
+    return true;
+}
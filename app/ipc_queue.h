@@ -0,0 +1,128 @@
+/**************************************************************************************************
+ *
+ * \file ipc_queue.h
+ *
+ * \brief Inter-core message queue interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_IPC_QUEUE_H
+#define _APP_IPC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Queue size in messages, must be a power of two                                               */
+#define IPC_QUEUE_SIZE      (16U)
+
+/**
+ * Orders shared memory accesses between producer and consumer. Messages and snapshot entries
+ * are copied through volatile pointers, so the compiler keeps those accesses in order with the
+ * volatile index and sequence updates. C28x cores see each other's writes in program order, so
+ * only hosted builds (threads) also need a real barrier.
+ */
+#if defined(__TMS320C28XX__)
+#define IPC_BARRIER()
+#else
+#define IPC_BARRIER()       __sync_synchronize()
+#endif
+
+/**************************************************************************************************
+ *
+ * Requests from the user interface to the core that owns CAN and the device registry
+ *
+ *************************************************************************************************/
+enum ipc_msg_type {
+    IPC_MSG_ON,                     /* Switch device on (arg != 0) or off                       */
+    IPC_MSG_MODE,                   /* Request operating mode arg                               */
+    IPC_MSG_SETPOINT,               /* Set setpoint arg to value                                */
+    IPC_MSG_CLEAR,                  /* Clear interlock (arg != 0)                               */
+};
+
+/**************************************************************************************************
+ *
+ * Queue message. Device type and stack are repeated so a request for a device that has moved
+ * or left in the meantime is dropped.
+ *
+ *************************************************************************************************/
+struct ipc_msg {
+    uint16_t type;                  /* Message type (enum ipc_msg_type)                         */
+    uint16_t dev;                   /* Device registry slot                                     */
+    uint16_t id;                    /* Device type (enum nfo_id)                                */
+    uint16_t stack;                 /* Device stack                                             */
+    uint16_t arg;                   /* Type-specific argument                                   */
+    float value;                    /* Type-specific value                                      */
+};
+
+/**************************************************************************************************
+ *
+ * Producer-side memory. Only the producer writes it, so on a dual-core build it sits in the
+ * producer's message RAM.
+ *
+ *************************************************************************************************/
+struct ipc_queue_tx {
+    struct ipc_msg msg[IPC_QUEUE_SIZE];
+    volatile uint16_t head;         /* Next slot to write                                       */
+};
+
+/**************************************************************************************************
+ *
+ * Consumer-side memory, in the consumer's message RAM on a dual-core build
+ *
+ *************************************************************************************************/
+struct ipc_queue_rx {
+    volatile uint16_t tail;         /* Next slot to read                                        */
+};
+
+/**************************************************************************************************
+ *
+ * Single-producer / single-consumer inter-core queue
+ *
+ *************************************************************************************************/
+struct ipc_queue {
+    struct ipc_queue_tx *tx;
+    struct ipc_queue_rx *rx;
+    uint32_t dropped;               /* Messages dropped because the queue was full (producer)   */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new inter-core queue object (user interface requests)
+ *
+ * \param None
+ *
+ * \return Inter-core queue object handler
+ *
+ *************************************************************************************************/
+extern struct ipc_queue *
+ipc_queue_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Pushes message into the queue. Must only be called from the producer.
+ *
+ * \param self inter-core queue object handler
+ * \param msg message
+ *
+ * \return True if message was queued; false if the queue was full
+ *
+ *************************************************************************************************/
+extern bool
+ipc_queue_push(struct ipc_queue *self, const struct ipc_msg *msg);
+
+/**************************************************************************************************
+ *
+ * \brief Pops oldest message from the queue. Must only be called from the consumer.
+ *
+ * \param self inter-core queue object handler
+ * \param msg Pointer to message buffer
+ *
+ * \return True if a message was read; false if the queue is empty
+ *
+ *************************************************************************************************/
+extern bool
+ipc_queue_pop(struct ipc_queue *self, struct ipc_msg *msg);
+
+#endif /* _APP_IPC_QUEUE_H */
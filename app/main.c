@@ -11,6 +11,7 @@
 #include "app/ctl.h"
 #include "app/hapi.h"
 #include "app/tlo.h"
+#include "app/acq.h"
 
 #include "inc/api/adc.h"
 #include "inc/api/task.h"
@@ -25,7 +26,13 @@
 __attribute__((ramfunc)) static void
 isr(const struct tlo *tlo)
 {
-    //adc_run(tlo->adc, ADC_OP_UPDATE);
+    /**
+     * Raw results only, filtering and conversion run per block in the PHY job. When blocks are
+     * moved by DMA or acquired by the CLA, the ADC no longer interrupts per sample and this is
+     * never reached.
+     */
+    hapi_adc_raw(acq_row(tlo->acq));
+    acq_push(tlo->acq);
 
 
     //read_key_coding(tlo->keys);
@@ -0,0 +1,302 @@
+/**************************************************************************************************
+ *
+ * \file page.c
+ *
+ * \brief Device page renderer implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/page.h"
+
+#include "app/atlas.h"
+#include "app/cell.h"
+#include "app/dev_snap.h"
+#include "app/dev_ctl.h"
+#include "app/fmt.h"
+#include "app/tlo.h"
+
+#include "app/display/state_machine.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/** Stack number field of the header (characters)                                                */
+#define PAGE_STACK_WIDTH    (3U)
+
+/**************************************************************************************************
+ *
+ * \brief Clears a rectangle of the frame, widened to whole bytes
+ *
+ *************************************************************************************************/
+static void
+page_clear(uint8_t *buf, int16_t x, int16_t y, uint16_t w, uint16_t h)
+{
+    int16_t lo = (x < 0) ? 0 : x / 2;
+    int16_t hi = (int16_t) ((x + (int16_t) w + 1) / 2);
+    if (hi > (int16_t) SCREEN_ROW_BYTES) {
+        hi = (int16_t) SCREEN_ROW_BYTES;
+    }
+    if (hi <= lo) {
+        return;
+    }
+
+    int16_t row;
+    for (row = y; row < y + (int16_t) h; row++) {
+        if (row >= 0 && row < (int16_t) SCREEN_HEIGHT) {
+            memset(&buf[(uint16_t) row * SCREEN_ROW_BYTES + (uint16_t) lo], 0u, (size_t) (hi - lo));
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * \brief Baseline of a line of text whose top edge is y. GFX fonts put about a quarter of the
+ * line height below the baseline.
+ *
+ *************************************************************************************************/
+static int16_t
+page_baseline(const struct page *self, int16_t y)
+{
+    return y + self->line_h - self->line_h / 4;
+}
+
+/**************************************************************************************************
+ *
+ * \brief Draws the header line: device icon, type and stack
+ *
+ *************************************************************************************************/
+static void
+page_header(struct page *self, const struct dev_snap_dev *dev)
+{
+    const struct atlas_bitmap *icon = &atlas_icon[ATLAS_ICON_MODULE];
+    char stack[PAGE_STACK_WIDTH + 1U];
+
+    atlas_draw(self->buf, 0, 0, icon, false);
+
+    int16_t x = (int16_t) icon->width + self->char_w;
+    int16_t y = page_baseline(self, 0);
+
+    x = atlas_text(self->buf, x, y, self->font, device_id_to_str((enum nfo_id) dev->id));
+
+    (void) fmt_fixed(stack, PAGE_STACK_WIDTH, (int32_t) dev->stack, 0U, NULL);
+    (void) atlas_text(self->buf, x, y, self->font, stack);
+}
+
+/**************************************************************************************************
+ *
+ * \brief Draws the bridge temperature at the right end of the header line, if its text changed
+ *
+ *************************************************************************************************/
+static bool
+page_temp(struct page *self, const struct dev_snap_dev *dev)
+{
+    char text[sizeof(self->temp_text)];
+
+    if (self->temp < 0 || (uint16_t) self->temp >= dev->n_mesurables) {
+        return false;
+    }
+
+    (void) fmt_float(text, PAGE_TEMP_WIDTH, dev->mesurables[self->temp], PAGE_TEMP_DECIMALS, "C");
+    if (strcmp(text, self->temp_text) == 0) {
+        return false;
+    }
+    strcpy(self->temp_text, text);
+
+    int16_t w = (int16_t) (PAGE_TEMP_WIDTH + 1U) * self->char_w;
+    int16_t x = (int16_t) SCREEN_WIDTH - w;
+
+    page_clear(self->buf, x, 0, (uint16_t) w, (uint16_t) self->line_h);
+    (void) atlas_text(self->buf, x, page_baseline(self, 0), self->font, text);
+
+    return true;
+}
+
+/**************************************************************************************************
+ *
+ * page_new()
+ *
+ *************************************************************************************************/
+struct page *
+page_new(void)
+{
+    static struct page page;
+    memset(&page, 0u, sizeof(struct page));
+
+    page.dev = -1;
+    page.temp = -1;
+
+    page.font = atlas_font_find(PAGE_FONT);
+    if (!page.font) {
+        if (atlas_font_size == 0U) {
+            return NULL;
+        }
+        page.font = &atlas_font[0];
+    }
+
+    /* Cell bounds are laid out in digit widths, values are right-aligned digits */
+    const struct atlas_font *font = page.font;
+    if ('0' >= font->first && '0' <= font->last) {
+        page.char_w = font->glyph['0' - font->first].x_advance;
+    }
+    page.line_h = (int16_t) font->y_advance;
+
+    return &page;
+}
+
+/**************************************************************************************************
+ *
+ * page_show()
+ *
+ *************************************************************************************************/
+int
+page_show(struct page *self, const struct tlo *tlo, int16_t dev, const struct can_dev *can_dev)
+{
+    uint16_t i;
+
+    if (!self || !tlo || !tlo->cells || (dev >= 0 && !can_dev)) {
+        return -1;
+    }
+
+    if (!cell_page_select(tlo->cells, dev, (dev < 0) ? -1 : 0)) {
+        return 0;
+    }
+
+    /* Drawn anew on the next render, the library may have drawn over the panel meanwhile */
+    self->dev = -1;
+    self->temp = -1;
+    memset(self->unit, 0u, sizeof(self->unit));
+
+    if (dev < 0) {
+        return 0;
+    }
+
+    if (can_dev->ops) {
+        self->temp = (int16_t) can_dev->ops->temp;
+    }
+
+    /* Custom view on a two by two grid below the header, units right after the values */
+    for (i = 0U; i < PAGE_CELLS; i++) {
+        int m = can_dev->custom_mesurables[i];
+        if (m < 0 || m >= DEV_mesurables_enum_end(can_dev)) {
+            continue;
+        }
+
+        const char *unit = DEV_mesurables_to_str(can_dev, m, UNIT);
+        int16_t x = (int16_t) ((i % 2U) * (SCREEN_WIDTH / 2U));
+        int16_t y = (int16_t) (i / 2U + 1U) * self->line_h;
+
+        uint16_t n = tlo->cells->n;
+        if (cell_bind(tlo->cells, (uint16_t) m, unit, x, y, CELL_WIDTH * (uint16_t) self->char_w,
+                (uint16_t) self->line_h) != NULL) {
+            self->unit[n] = unit;
+        }
+    }
+
+    return 0;
+}
+
+/**************************************************************************************************
+ *
+ * page_selected()
+ *
+ *************************************************************************************************/
+int16_t
+page_selected(const struct tlo *tlo)
+{
+    if (!tlo || !tlo->state_machine || !tlo->dev_ctl ||
+        tlo->state_machine->currentState != state_main) {
+        return -1;
+    }
+
+    int16_t i;
+    for (i = 0; i < N_DEVICES; i++) {
+        const struct can_dev *can_dev = &tlo->dev_ctl->can_dev[i];
+        if (can_dev->present && can_dev->compatible) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**************************************************************************************************
+ *
+ * page_follow()
+ *
+ *************************************************************************************************/
+int
+page_follow(struct page *self, const struct tlo *tlo)
+{
+    if (!self || !tlo || !tlo->dev_ctl) {
+        return -1;
+    }
+
+    int16_t dev = page_selected(tlo);
+
+    return page_show(self, tlo, dev, (dev >= 0) ? &tlo->dev_ctl->can_dev[dev] : NULL);
+}
+
+/**************************************************************************************************
+ *
+ * page_draw()
+ *
+ *************************************************************************************************/
+int
+page_draw(struct page *self, struct cell_page *cells, const struct dev_snap *dev_snap)
+{
+    struct dev_snap_dev dev;
+    int ret = 0;
+    uint16_t i;
+
+    if (!self || !cells || !dev_snap || cells->dev < 0) {
+        if (self) {
+            self->dev = -1;
+        }
+        return -1;
+    }
+
+    /* Another device: start from a blank frame, every cell is drawn */
+    if (self->dev != cells->dev) {
+        memset(self->buf, 0u, sizeof(self->buf));
+
+        self->temp_text[0] = '\0';
+        if (dev_snap_read(dev_snap, (uint16_t) cells->dev, &dev) == 0) {
+            page_header(self, &dev);
+            (void) page_temp(self, &dev);
+            (void) cell_page_update(cells, &dev);
+        }
+
+        for (i = 0U; i < cells->n; i++) {
+            struct cell *cell = &cells->cell[i];
+
+            cell->dirty = cell->valid;
+            (void) atlas_text(self->buf, cell->x + (int16_t) cell->w,
+                page_baseline(self, cell->y), self->font, self->unit[i]);
+        }
+
+        self->dev = cells->dev;
+        self->pages++;
+        ret = 1;
+    } else if (self->temp >= 0 && dev_snap_read(dev_snap, (uint16_t) cells->dev, &dev) == 0) {
+        /* Not a value cell, follows the snapshot at every render */
+        (void) page_temp(self, &dev);
+    }
+
+    for (i = 0U; i < cells->n; i++) {
+        struct cell *cell = &cells->cell[i];
+
+        if (!cell->dirty) {
+            continue;
+        }
+
+        page_clear(self->buf, cell->x, cell->y, cell->w, cell->h);
+        (void) atlas_text(self->buf, cell->x, page_baseline(self, cell->y), self->font, cell->text);
+
+        cell->dirty = false;
+        self->cells++;
+    }
+
+    return ret;
+}
@@ -0,0 +1,138 @@
+/**************************************************************************************************
+ *
+ * \file page.h
+ *
+ * \brief Device page renderer interface. Draws the value cells of the device page into a frame
+ * in RAM with the pre-packed atlas, for screen_flush() to send in slices. Only the cells whose
+ * text changed are redrawn.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_PAGE_H
+#define _APP_PAGE_H
+
+#include "app/screen.h"
+#include "app/cell.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Forward declarations
+ *
+ *************************************************************************************************/
+
+struct tlo;
+struct can_dev;
+struct atlas_font;
+struct dev_snap;
+
+/** Value cells of the device page, one per custom view mesurable (can_dev.custom_mesurables)   */
+#define PAGE_CELLS          (4U)
+
+/** Bridge temperature field of the header (characters) and its digits after the decimal point */
+#define PAGE_TEMP_WIDTH     (6U)
+#define PAGE_TEMP_DECIMALS  (1U)
+
+/** Font of the device page, the first font of the atlas is used if it is not in there          */
+#define PAGE_FONT           "FreeMono9pt7b"
+
+/**************************************************************************************************
+ *
+ * Device page renderer object definition
+ *
+ *************************************************************************************************/
+struct page {
+    int16_t dev;                    /* Device registry slot drawn into buf, -1 if none          */
+    const struct atlas_font *font;
+    int16_t char_w;                 /* Cursor advance of a digit (pixels)                       */
+    int16_t line_h;                 /* Line height (pixels)                                     */
+    const char *unit[CELL_PAGE_MAX];    /* Unit drawn after each cell, NULL if none             */
+    int16_t temp;                   /* Mesurable holding the bridge temperature, -1 if none     */
+    char temp_text[PAGE_TEMP_WIDTH + 2U];   /* Bridge temperature drawn in the header           */
+    uint32_t pages;                 /* Pages drawn anew since start-up                          */
+    uint32_t cells;                 /* Cells redrawn since start-up                             */
+    uint8_t buf[SCREEN_BUF_SIZE];   /* Frame, handed over to screen_flush()                     */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new device page renderer
+ *
+ * \param None
+ *
+ * \return Device page renderer object handler; NULL if the atlas has no font
+ *
+ *************************************************************************************************/
+extern struct page *
+page_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Shows the custom view of a device, or goes back to the pages drawn by the SSD1322
+ * library. Called through page_follow() by the screen job after every state machine run. Value
+ * cells are bound to the custom view mesurables of the device here; the page is then drawn by the
+ * screen job. Showing the device already shown does nothing.
+ *
+ * \param self device page renderer object handler
+ * \param tlo top-level object handler
+ * \param dev device registry slot; -1 to stop showing the device page
+ * \param can_dev device, for its custom view and driver strings; ignored if dev is -1
+ *
+ * \return 0 if operation is successful; -1 otherwise
+ *
+ *************************************************************************************************/
+extern int
+page_show(struct page *self, const struct tlo *tlo, int16_t dev, const struct can_dev *can_dev);
+
+/**************************************************************************************************
+ *
+ * \brief Device the state machine shows on its main view. Its device selection is not visible
+ * from here, so this is the first device present and supported, in registry order.
+ *
+ * \param tlo top-level object handler
+ *
+ * \return Device registry slot; -1 outside the main view or if there is no device
+ *
+ *************************************************************************************************/
+extern int16_t
+page_selected(const struct tlo *tlo);
+
+/**************************************************************************************************
+ *
+ * \brief Makes the device page follow the state machine: the device of page_selected() is shown
+ * on the main view, and the library pages everywhere else. Called by the screen job right after
+ * state_machine_run().
+ *
+ * \param self device page renderer object handler
+ * \param tlo top-level object handler
+ *
+ * \return 0 if operation is successful; -1 otherwise
+ *
+ *************************************************************************************************/
+extern int
+page_follow(struct page *self, const struct tlo *tlo);
+
+/**************************************************************************************************
+ *
+ * \brief Brings the frame up to date with the cells of the page being shown. A device other than
+ * the one in the frame is drawn anew: header, units and every cell, with fresh values from the
+ * snapshot. Otherwise only dirty cells, and the bridge temperature if its text changed, are
+ * redrawn. Cells are marked clean once drawn. The frame
+ * must not be being sent (screen_busy()).
+ *
+ * \param self device page renderer object handler
+ * \param cells cell cache of the page being shown
+ * \param dev_snap device registry snapshot
+ *
+ * \return 1 if the page was drawn anew; 0 if only changed cells were redrawn; -1 if no device
+ * page is being shown
+ *
+ *************************************************************************************************/
+extern int
+page_draw(struct page *self, struct cell_page *cells, const struct dev_snap *dev_snap);
+
+#endif /* _APP_PAGE_H */
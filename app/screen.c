@@ -0,0 +1,423 @@
+/**************************************************************************************************
+ *
+ * \file screen.c
+ *
+ * \brief Time-sliced screen refresh implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/screen.h"
+
+#include "app/tlo.h"
+#include "app/hapi.h"
+#include "app/task_evt.h"
+#include "app/dev_snap.h"
+#include "app/cell.h"
+#include "app/page.h"
+
+#include "app/display/state_machine.h"
+
+#include "inc/lib/debug.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/** SSD1322 commands                                                                              */
+#define SCREEN_CMD_COLUMN   (0x15U)
+#define SCREEN_CMD_ROW      (0x75U)
+#define SCREEN_CMD_WRITE    (0x5CU)
+
+/** The 256 pixel panel sits in the middle of the 480 pixel controller RAM (4 pixels per column) */
+#define SCREEN_COL_START    (0x1CU)
+#define SCREEN_COL_END      (SCREEN_COL_START + (SCREEN_WIDTH / 4U) - 1U)
+
+#define SCREEN_TICKS_US     (HAPI_TIMESTAMP_FREQ / 1000000UL)
+#define SCREEN_TICKS_MS     (HAPI_TIMESTAMP_FREQ / 1000UL)
+
+/**************************************************************************************************
+ *
+ * \brief Sends command with its arguments
+ *
+ *************************************************************************************************/
+static int
+screen_command(uint8_t cmd, const uint8_t *arg, uint16_t n)
+{
+    int ret = hapi_screen_write(&cmd, 1U, true);
+
+    if (ret == 0 && n > 0U) {
+        ret = hapi_screen_write(arg, n, false);
+    }
+
+    return ret;
+}
+
+/**************************************************************************************************
+ *
+ * \brief Sets display RAM window and starts RAM write
+ *
+ *************************************************************************************************/
+static int
+screen_window(uint16_t col_lo, uint16_t col_hi, uint16_t row_lo, uint16_t row_hi)
+{
+    const uint8_t col[2] = { SCREEN_COL_START + col_lo, SCREEN_COL_START + col_hi };
+    const uint8_t row[2] = { row_lo, row_hi };
+
+    int ret = 0;
+    ret |= screen_command(SCREEN_CMD_COLUMN, col, 2U);
+    ret |= screen_command(SCREEN_CMD_ROW, row, 2U);
+    ret |= screen_command(SCREEN_CMD_WRITE, NULL, 0U);
+
+    return ret;
+}
+
+/**************************************************************************************************
+ *
+ * \brief Starts DMA transfer of the current row of the dirty window
+ *
+ *************************************************************************************************/
+static void screen_tx_done(void *ctx);
+
+static int
+screen_send_row(struct screen *self)
+{
+    uint16_t offset = self->row * SCREEN_ROW_BYTES + self->col_lo * SCREEN_COL_BYTES;
+    uint16_t length = (self->col_hi - self->col_lo + 1U) * SCREEN_COL_BYTES;
+
+    return hapi_screen_send(&self->buf[offset], length, screen_tx_done, self);
+}
+
+/**************************************************************************************************
+ *
+ * \brief Transfer completion, runs in SPI interrupt context. Chains the next row of the window,
+ * so the whole window goes out without waiting for the screen job.
+ *
+ *************************************************************************************************/
+static void
+screen_tx_done(void *ctx)
+{
+    struct screen *self = (struct screen *) ctx;
+
+    self->bytes += (self->col_hi - self->col_lo + 1U) * SCREEN_COL_BYTES;
+
+    if (++self->row < self->row_end) {
+        if (screen_send_row(self) == 0) {
+            return;
+        }
+        self->tx_error = true;
+    }
+
+    self->tx_active = false;
+}
+
+/**************************************************************************************************
+ *
+ * \brief Finds the columns of a row that differ from the panel contents
+ *
+ *************************************************************************************************/
+static void
+screen_scan_row(struct screen *self, uint16_t row)
+{
+    const uint8_t *buf = &self->buf[row * SCREEN_ROW_BYTES];
+    const uint8_t *shown = &self->shown[row * SCREEN_ROW_BYTES];
+    uint16_t lo = 0xFFU;
+    uint16_t hi = 0U;
+
+    if (!self->shown_valid) {
+        lo = 0U;
+        hi = SCREEN_COLS - 1U;
+    } else {
+        uint16_t i;
+        for (i = 0U; i < SCREEN_ROW_BYTES; i++) {
+            if ((buf[i] ^ shown[i]) & 0xFFU) {
+                uint16_t col = i / SCREEN_COL_BYTES;
+                if (lo == 0xFFU) {
+                    lo = col;
+                }
+                hi = col;
+            }
+        }
+    }
+
+    self->dirty_lo[row] = lo;
+    self->dirty_hi[row] = hi;
+}
+
+/**************************************************************************************************
+ *
+ * \brief Moves pending frame into the pipeline
+ *
+ *************************************************************************************************/
+static void
+screen_next(struct screen *self)
+{
+    if (self->next) {
+        self->buf = self->next;
+        self->next = NULL;
+        self->row = 0U;
+        self->changed = false;
+        self->state = SCREEN_SCAN;
+    } else {
+        self->buf = NULL;
+        self->state = SCREEN_IDLE;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * \brief Ends frame. A frame that failed to go out leaves the panel contents unknown.
+ *
+ *************************************************************************************************/
+static void
+screen_done(struct screen *self, bool sent)
+{
+    self->shown_valid = sent;
+
+    screen_next(self);
+}
+
+/**************************************************************************************************
+ *
+ * \brief Checks if something shown changed since the last render: a device appeared or left, or
+ * a value cell of the page moved to another display step
+ *
+ *************************************************************************************************/
+static bool
+screen_changed(struct screen *self, const struct tlo *tlo)
+{
+    bool changed = false;
+
+    if (!tlo->dev_snap) {
+        return false;
+    }
+
+    if (tlo->dev_snap->generation != self->generation) {
+        self->generation = tlo->dev_snap->generation;
+        changed = true;
+    }
+
+    if (tlo->cells && tlo->cells->dev >= 0) {
+        struct dev_snap_dev dev;
+
+        if (dev_snap_read(tlo->dev_snap, (uint16_t) tlo->cells->dev, &dev) == 0 &&
+            cell_page_update(tlo->cells, &dev) > 0U) {
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/**************************************************************************************************
+ *
+ * screen_new()
+ *
+ *************************************************************************************************/
+struct screen *
+screen_new(void)
+{
+    static struct screen screen;
+    memset(&screen, 0u, sizeof(struct screen));
+
+    /* Panel RAM content is unknown, first page is rendered right away */
+    screen.state = SCREEN_IDLE;
+    screen.shown_valid = false;
+    screen.last_render = hapi_timestamp() - SCREEN_REFRESH_MAX_MS * SCREEN_TICKS_MS;
+
+    return &screen;
+}
+
+/**************************************************************************************************
+ *
+ * screen_flush()
+ *
+ *************************************************************************************************/
+int
+screen_flush(struct screen *self, const uint8_t *buf)
+{
+    if (!self || !buf) {
+        return -1;
+    }
+
+    self->next = buf;
+
+    if (self->state == SCREEN_IDLE) {
+        screen_next(self);
+    }
+
+    return 0;
+}
+
+/**************************************************************************************************
+ *
+ * screen_invalidate()
+ *
+ *************************************************************************************************/
+void
+screen_invalidate(struct screen *self)
+{
+    if (self) {
+        self->shown_valid = false;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * screen_busy()
+ *
+ *************************************************************************************************/
+bool
+screen_busy(const struct screen *self)
+{
+    return self && (self->state != SCREEN_IDLE || self->next != NULL);
+}
+
+/**************************************************************************************************
+ *
+ * screen_run()
+ *
+ *************************************************************************************************/
+void
+screen_run(struct screen *self, const struct tlo *tlo)
+{
+    ASSERT(self && tlo);
+
+    uint32_t start = hapi_timestamp();
+
+    switch (self->state) {
+    case SCREEN_IDLE: {
+        /* Changes are picked up at most every SCREEN_REFRESH_MIN_MS on the device page, and every
+         * SCREEN_REFRESH_LIB_MS on the blocking library pages, requests wait until then */
+        uint32_t since = start - self->last_render;
+        uint32_t min = self->sliced ? SCREEN_REFRESH_MIN_MS : SCREEN_REFRESH_LIB_MS;
+        if (since < min * SCREEN_TICKS_MS) {
+            break;
+        }
+
+        bool due = (task_evt_take(tlo->task_evt, TASK_EVT_SCREEN) != 0U);
+        due |= screen_changed(self, tlo);
+        if (!due && since < SCREEN_REFRESH_MAX_MS * SCREEN_TICKS_MS) {
+            break;
+        }
+        self->last_render = start;
+        self->renders++;
+
+        /**
+         * The state machine runs first, pages of its own are drawn by the SSD1322 library, which
+         * writes to the panel itself and runs to completion in this slot. The device page is
+         * drawn into RAM instead and goes out in slices below, only the cells that changed.
+         */
+        state_machine_run(tlo->state_machine);
+        (void) page_follow(tlo->page, tlo);
+
+        int drawn = page_draw(tlo->page, tlo->cells, tlo->dev_snap);
+        if (drawn > 0) {
+            /* The library drew over the panel since this page was last shown */
+            screen_invalidate(self);
+        }
+        if (drawn >= 0) {
+            (void) screen_flush(self, tlo->page->buf);
+        }
+        self->sliced = (drawn >= 0);
+        break;
+    }
+
+    case SCREEN_SCAN:
+        for (;;) {
+            screen_scan_row(self, self->row);
+
+            if (self->dirty_lo[self->row] != 0xFFU) {
+                self->changed = true;
+            }
+
+            if (++self->row >= SCREEN_HEIGHT) {
+                self->row = 0U;
+                self->state = SCREEN_WINDOW;
+                break;
+            }
+
+            if ((hapi_timestamp() - start) >= SCREEN_SLICE_US * SCREEN_TICKS_US) {
+                break;
+            }
+        }
+        break;
+
+    case SCREEN_WINDOW: {
+        /* Next run of dirty rows, sent as one window spanning all their dirty columns */
+        while (self->row < SCREEN_HEIGHT && self->dirty_lo[self->row] == 0xFFU) {
+            self->row++;
+        }
+
+        if (self->row >= SCREEN_HEIGHT) {
+            if (self->changed) {
+                self->frames++;
+            }
+            screen_done(self, true);
+            break;
+        }
+
+        uint16_t end = self->row;
+        self->col_lo = SCREEN_COLS - 1U;
+        self->col_hi = 0U;
+        while (end < SCREEN_HEIGHT && self->dirty_lo[end] != 0xFFU) {
+            if (self->dirty_lo[end] < self->col_lo) {
+                self->col_lo = self->dirty_lo[end];
+            }
+            if (self->dirty_hi[end] > self->col_hi) {
+                self->col_hi = self->dirty_hi[end];
+            }
+            end++;
+        }
+        self->row_end = end;
+
+        if (screen_window(self->col_lo, self->col_hi, self->row, end - 1U) < 0) {
+            screen_done(self, false);
+            break;
+        }
+
+        /* Rows go out by DMA, the completion interrupt chains them until the window is done */
+        self->win_row = self->row;
+        self->tx_error = false;
+        self->tx_active = true;
+        if (screen_send_row(self) < 0) {
+            self->tx_active = false;
+            screen_done(self, false);
+            break;
+        }
+        self->state = SCREEN_DATA;
+        break;
+    }
+
+    case SCREEN_DATA: {
+        if (self->tx_active) {
+            break;
+        }
+
+        if (self->tx_error) {
+            screen_done(self, false);
+            break;
+        }
+
+        /* Window is on the panel, remember what was sent */
+        uint16_t length = (self->col_hi - self->col_lo + 1U) * SCREEN_COL_BYTES;
+        uint16_t row;
+        for (row = self->win_row; row < self->row_end; row++) {
+            uint16_t offset = row * SCREEN_ROW_BYTES + self->col_lo * SCREEN_COL_BYTES;
+            memcpy(&self->shown[offset], &self->buf[offset], length);
+        }
+
+        self->state = SCREEN_WINDOW;
+        break;
+    }
+
+    default:
+        screen_next(self);
+        break;
+    }
+
+    uint32_t elapsed = hapi_timestamp() - start;
+    if (elapsed > self->slice_max) {
+        self->slice_max = elapsed;
+    }
+}
@@ -0,0 +1,163 @@
+/**************************************************************************************************
+ *
+ * \file screen.h
+ *
+ * \brief Time-sliced screen refresh interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_SCREEN_H
+#define _APP_SCREEN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Forward declarations
+ *
+ *************************************************************************************************/
+
+struct tlo;
+
+/** SSD1322 panel geometry, 4 bits per pixel                                                      */
+#define SCREEN_WIDTH        (256U)
+#define SCREEN_HEIGHT       (64U)
+#define SCREEN_ROW_BYTES    (SCREEN_WIDTH / 2U)
+#define SCREEN_BUF_SIZE     (SCREEN_ROW_BYTES * SCREEN_HEIGHT)
+
+/** Display RAM columns hold 4 pixels (2 bytes), the smallest window width                       */
+#define SCREEN_COLS         (SCREEN_WIDTH / 4U)
+#define SCREEN_COL_BYTES    (2U)
+
+/** Screen job time budget per run (us). A slice always sends at least one row.                  */
+#define SCREEN_SLICE_US     (150UL)
+
+/** Shortest interval between two renders, and longest one for clock and blinking elements (ms) */
+#define SCREEN_REFRESH_MIN_MS   (40UL)
+#define SCREEN_REFRESH_MAX_MS   (500UL)
+
+/** Shortest interval between two renders of library pages, which block the slot task (ms)      */
+#define SCREEN_REFRESH_LIB_MS   (100UL)
+
+/**************************************************************************************************
+ *
+ * Screen refresh pipeline stages. Each call to screen_run() resumes where the previous one
+ * stopped.
+ *
+ *************************************************************************************************/
+enum screen_state {
+    SCREEN_IDLE,                    /* Waiting for the next render                              */
+    SCREEN_SCAN,                    /* Comparing frame with panel contents                      */
+    SCREEN_WINDOW,                  /* Looking for the next dirty window                        */
+    SCREEN_DATA,                    /* Waiting for dirty window rows to go out by DMA           */
+};
+
+/**************************************************************************************************
+ *
+ * Screen refresh object definition
+ *
+ *************************************************************************************************/
+struct screen {
+    enum screen_state state;
+    const uint8_t *buf;             /* Frame being sent                                         */
+    const uint8_t *next;            /* Frame handed over while the previous one was being sent  */
+    uint16_t row;                   /* Next row to scan or send                                 */
+    uint16_t row_end;               /* End of the dirty window being sent                       */
+    uint16_t win_row;               /* First row of the dirty window being sent                 */
+    uint16_t col_lo;                /* First column of the dirty window being sent              */
+    uint16_t col_hi;                /* Last column of the dirty window being sent               */
+    uint8_t dirty_lo[SCREEN_HEIGHT];    /* First dirty column per row, 0xFF if row is clean     */
+    uint8_t dirty_hi[SCREEN_HEIGHT];    /* Last dirty column per row                            */
+    uint8_t shown[SCREEN_BUF_SIZE]; /* Panel contents                                           */
+    bool shown_valid;               /* False until the whole panel has been written once        */
+    bool changed;                   /* Frame being sent differs from the panel contents         */
+    volatile bool tx_active;        /* Window rows are being sent by DMA                        */
+    volatile bool tx_error;         /* A window row could not be started                        */
+    uint32_t last_render;           /* Start of last render (hapi_timestamp() ticks)            */
+    uint16_t generation;            /* Device registry generation at the last render            */
+    bool sliced;                    /* Last render was the device page, sent in slices          */
+    uint32_t slice_max;             /* Longest screen job run (hapi_timestamp() ticks)          */
+    uint32_t renders;               /* Pages rendered since start-up                            */
+    uint32_t frames;                /* Frames with changes sent since start-up                  */
+    volatile uint32_t bytes;        /* Frame bytes sent since start-up                          */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new screen refresh object
+ *
+ * \param None
+ *
+ * \return Screen refresh object handler
+ *
+ *************************************************************************************************/
+extern struct screen *
+screen_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Hands a frame rendered into RAM over for sending, in slices, in place of a blocking
+ * buffer transfer. Pages drawn by the SSD1322 library write to the panel themselves and do not
+ * go through here. The buffer must stay untouched until screen_busy() returns false. If a frame
+ * is still being sent, the new one is sent next; only the newest pending frame is kept.
+ *
+ * \param self screen refresh object handler
+ * \param buf frame buffer, SCREEN_BUF_SIZE bytes
+ *
+ * \return 0 if operation is successful; -1 otherwise
+ *
+ *************************************************************************************************/
+extern int
+screen_flush(struct screen *self, const uint8_t *buf);
+
+/**************************************************************************************************
+ *
+ * \brief Forgets the panel contents, so the next frame is sent in full. Call after the display
+ * controller was reset.
+ *
+ * \param self screen refresh object handler
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+screen_invalidate(struct screen *self);
+
+/**************************************************************************************************
+ *
+ * \brief Checks if a frame is being sent or waiting to be sent
+ *
+ * \param self screen refresh object handler
+ *
+ * \return True if busy; false otherwise
+ *
+ *************************************************************************************************/
+extern bool
+screen_busy(const struct screen *self);
+
+/**************************************************************************************************
+ *
+ * \brief Runs one slice of the screen pipeline. It renders the current page when something it
+ * shows changed: TASK_EVT_SCREEN raised (key input), a device appeared or left, or a value cell of
+ * the device page (tlo->cells, bound by page_follow()) changed its text. Renders run to completion
+ * and are at most SCREEN_REFRESH_MAX_MS apart. They are at least SCREEN_REFRESH_MIN_MS apart on
+ * the device page, and SCREEN_REFRESH_LIB_MS on the library pages, which are drawn in one go and
+ * hold the slot task up for the whole render. The device page is drawn into RAM and handed over
+ * through screen_flush(); each such frame is compared with the panel contents and only the changed
+ * windows are sent, until the SCREEN_SLICE_US budget is used up, then the job yields. Window rows
+ * are sent by DMA; the job only sets up each window and then polls for its completion. The next
+ * call continues where this one stopped.
+ *
+ * \param self screen refresh object handler
+ * \param tlo top-level object handler
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+screen_run(struct screen *self, const struct tlo *tlo);
+
+#endif /* _APP_SCREEN_H */
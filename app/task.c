@@ -11,6 +11,16 @@
 #include "app/task.h"
 
 #include "app/tlo.h"
+#include "app/can_filter.h"
+#include "app/can_rx.h"
+#include "app/can_tx.h"
+#include "app/task_prof.h"
+#include "app/screen.h"
+#include "app/task_evt.h"
+#include "app/task_slot.h"
+#include "app/acq.h"
+#include "app/ipc_queue.h"
+#include "app/dev_snap.h"
 #include "app/wcs.h"
 #include "app/adc.h"
 #include "app/ctl.h"
@@ -43,11 +53,17 @@
 static void
 callback_can(const struct tlo *tlo)
 {
-    
-    /*const struct db * db_a[4];
-    db_a[0] =  (const struct db *) tlo->db;
-    db_a[1] =  (const struct db *) tlo->db_afe;*/
+    struct can_rx_frame frame;
+    struct ipc_msg msg;
+    int served;
+
+    /* Taken before the work, frames arriving from now on activate the next run */
+    (void) task_evt_take(tlo->task_evt, TASK_EVT_CAN_RX | TASK_EVT_CAN_TX);
 
+    /* Device type broadcasts are taken by the receive interrupt, they only concern the registry */
+    while (can_rx_pop(tlo->can_rx, &frame)) {
+        (void) dev_ctl_update_devices(tlo, &frame.f);
+    }
 
     const struct db * db[]={
         (const struct db *) tlo->db,
@@ -65,28 +81,58 @@ callback_can(const struct tlo *tlo)
 
 
     
-    //tlo->ctl->can_lock = true;
     uint16_t can_size =  sizeof(db)/sizeof(db[0]);
 
-    db_run(tlo->can, db, can_size);
+    /* Requests from the user interface are applied to the registry before it is scanned */
+    while (ipc_queue_pop(tlo->ui_cmd, &msg)) {
+        dev_ctl_request(tlo->dev_ctl, &msg);
+    }
+
+    /* Setpoint, on/off, mode and interlock clear requests queue their device */
+    can_tx_scan(tlo->can_tx, tlo->dev_ctl);
 
+    /* fw_lib and the receive interrupt share the controller interface registers */
+    hapi_can_lock(true);
 
+    /* fw_lib's receive objects follow the user interface state and the devices present */
+    (void) can_filter_update(tlo->can_filter, tlo);
 
-    //we subscribe only to send a message then unsubscribe to keep receiving all message
-    db_unsubscribe((const struct db *) tlo->db_afe);
-    db_unsubscribe((const struct db *) tlo->db_vg11_fm01);
-    db_unsubscribe((const struct db *) tlo->db_vg11_fm02);
+    /**
+     * Every other frame is read and decoded by the databases. The exception filter of our own
+     * database hands each one to the device registry first.
+     *
+     * Frames are still matched against every database in the list. db_run() is the only decode
+     * entry point fw_lib has: it reads the message objects itself and takes no frame, so a
+     * table from message ID to database has nothing to hand a frame to. Routing by ID needs
+     * fw_lib to decode one given message of one database.
+     */
+    do {
+        /* Queued devices go out in one burst, one database run each */
+        served = can_tx_begin(tlo->can_tx, tlo);
 
+        db_run(tlo->can, db, can_size);
 
-    //tlo->ctl->can_lock = false;
-    dev_ctl_update_timestamp(tlo->dev_ctl);
+        can_tx_end(tlo->can_tx, tlo);
+    } while (served && tlo->can_tx->count > 0U);
+
+    hapi_can_lock(false);
 }
 
 
+/**************************************************************************************************
+ * 
+ * \brief Callback function for screen refresh. Runs one step of the screen pipeline: either a
+ * page render, or one time-sliced part of sending a frame handed over through screen_flush().
+ * 
+ * \param tlo top-level object handler
+ * 
+ * \return None
+ * 
+ *************************************************************************************************/
 static void
 callback_screen(const struct tlo *tlo)
 {
-    state_machine_run(tlo->state_machine);
+    screen_run(tlo->screen, tlo);
 }
 
 
@@ -126,16 +172,22 @@ callback_blink(const struct tlo *tlo)
 static void
 callback_meas(const struct tlo *tlo)
 {
+    uint16_t evt = task_evt_take(tlo->task_evt, TASK_EVT_KEY);
    
     //adc_run(tlo->adc, ADC_OP_FILTER);
     read_key_button(tlo->keys);
     read_key_coding(tlo->keys);
-  
+
+    //the encoder moved or a button changed, show the result with the next render
+    if (evt != 0U) {
+        task_evt_set(tlo->task_evt, TASK_EVT_SCREEN);
+    }
 }
 
 /**************************************************************************************************
  * 
- * \brief Callback function for physical measurements
+ * \brief Callback function for physical measurements. The ADC interrupt only stores raw
+ * results, filtering and conversion to physical units run here once per completed block.
  * 
  * \param tlo top-level object handler
  * 
@@ -145,7 +197,9 @@ callback_meas(const struct tlo *tlo)
 static void
 callback_phy(const struct tlo *tlo)
 {
-    //adc_run(tlo->adc, ADC_OP_PHYSICAL);
+    (void) task_evt_take(tlo->task_evt, TASK_EVT_ACQ);
+
+    acq_run(tlo->acq);
     //read_key_coding(tlo->keys);
 }
 
@@ -161,18 +215,85 @@ callback_phy(const struct tlo *tlo)
 static void
 callback_ctl(const struct tlo *tlo)
 {
-    //check if dev are alive
-    dev_ctl_update_timestamp(tlo->dev_ctl);
+    static uint32_t snap_at = 0U;
 
-    static unsigned counter = 0U;
-    int max_counter = 1000;   
-    if (++counter >=max_counter) { //check avery sec
-        dev_ctl_check_alive(tlo->dev_ctl);
+    //advance the ms clock by the time elapsed on the hardware counter, devices whose deadline
+    //is due are checked for being alive
+    dev_ctl_update_timestamp(tlo->dev_ctl);
 
+    //publish the registry for the user interface, a few times per screen refresh
+    if( (int32_t) (tlo->dev_ctl->timestamp - snap_at) >= 0 ){
+        dev_snap_publish(tlo->dev_snap, tlo->dev_ctl);
+        snap_at = tlo->dev_ctl->timestamp + C_TASK_SNAP_MS;
     }
 
    //ctl_background(tlo->ctl);
 }
+
+/**************************************************************************************************
+ * 
+ * \brief Callback function for scheduler diagnostics
+ * 
+ * \param tlo top-level object handler
+ * 
+ * \return None
+ * 
+ *************************************************************************************************/
+static void
+callback_diag(const struct tlo *tlo)
+{
+    //one job statistics frame per run, the whole set goes out in under a second
+    task_prof_publish(tlo->task_prof, tlo);
+}
+
+/**************************************************************************************************
+ * 
+ * Profiled job callbacks
+ * 
+ *************************************************************************************************/
+TASK_PROF_CALLBACK(TASK_PROF_CAN, callback_can)
+TASK_PROF_CALLBACK(TASK_PROF_BLINK, callback_blink)
+TASK_PROF_CALLBACK(TASK_PROF_SCREEN, callback_screen)
+TASK_PROF_CALLBACK(TASK_PROF_MEAS, callback_meas)
+TASK_PROF_CALLBACK(TASK_PROF_PHY, callback_phy)
+TASK_PROF_CALLBACK(TASK_PROF_CTL, callback_ctl)
+TASK_PROF_CALLBACK(TASK_PROF_DIAG, callback_diag)
+
+/**************************************************************************************************
+ * 
+ * 1 kHz jobs, one per slot. CAN is first so it starts on the period boundary, the screen is
+ * last so its time slice never delays the others. A job with activation events runs when one of
+ * them is raised, and at its fallback period otherwise.
+ * 
+ *************************************************************************************************/
+static const struct task_slot_job task_slot_job[C_TASK_SLOTS] = {
+    { callback_can_prof,    TASK_EVT_CAN_RX | TASK_EVT_CAN_TX,  C_TASK_CAN_FALLBACK_MS, 0U },
+    { callback_meas_prof,   TASK_EVT_KEY,   C_TASK_KEY_FALLBACK_MS, C_TASK_KEY_HOLD_MS },
+    { callback_phy_prof,    TASK_EVT_ACQ,   C_TASK_ACQ_FALLBACK_MS, 0U },
+    { callback_ctl_prof,    0U,             1U,                     0U },
+    { callback_screen_prof, TASK_EVT_SCREEN, 1U,                    0U },
+};
+
+static struct task_slot *task_slot = NULL;
+
+/**************************************************************************************************
+ * 
+ * \brief Callback function for 1 kHz job slots. The slot task runs C_TASK_SLOTS times per
+ * millisecond and each run dispatches the next 1 kHz job, so the jobs are spread evenly over
+ * the period instead of becoming due on the same tick and running back-to-back. CAN no longer
+ * waits for the others on every tick, and jobs with nothing to do skip their slot.
+ * 
+ * \param tlo top-level object handler
+ * 
+ * \return None
+ * 
+ *************************************************************************************************/
+static void
+callback_slot(const struct tlo *tlo)
+{
+    task_slot_run(task_slot, tlo->task_evt, tlo);
+}
+
 /**************************************************************************************************
  * 
  * task_new()
@@ -185,20 +306,29 @@ task_new(const struct tlo *tlo)
 
     volatile  int ret;
 
-    TASK_JOB_NEW(can,   C_TASK_FREQ_CAN, callback_can);
-    TASK_JOB_NEW(blink,  10U, callback_blink);
-    TASK_JOB_NEW(screen,   10U, callback_screen);
-    TASK_JOB_NEW(meas,  C_TASK_FREQ_MEAS  , callback_meas);
-    TASK_JOB_NEW(phy,   C_TASK_FREQ_MEAS , callback_phy);
-    TASK_JOB_NEW(ctl,   1000, callback_ctl);
+    /* can, meas, phy, ctl and screen run at 1 kHz in consecutive slots of the slot task */
+    task_slot = task_slot_new(task_slot_job, C_TASK_SLOTS);
+    if (!task_slot) {
+        return NULL;
+    }
+
+    TASK_JOB_NEW(slot,  C_TASK_FREQ_SLOT, callback_slot);
+    TASK_JOB_NEW(blink,  10U, callback_blink_prof);
+    TASK_JOB_NEW(diag,  C_TASK_FREQ_DIAG, callback_diag_prof);
+
+    /* Event-driven jobs are only late when they miss their fallback period */
+    task_prof_register(tlo->task_prof, TASK_PROF_CAN, "CAN", 1000.0f / C_TASK_CAN_FALLBACK_MS);
+    task_prof_register(tlo->task_prof, TASK_PROF_BLINK, "BLINK", 10.0f);
+    task_prof_register(tlo->task_prof, TASK_PROF_SCREEN, "SCREEN", C_TASK_FREQ_SLOT / C_TASK_SLOTS);
+    task_prof_register(tlo->task_prof, TASK_PROF_MEAS, "MEAS", 1000.0f / C_TASK_KEY_FALLBACK_MS);
+    task_prof_register(tlo->task_prof, TASK_PROF_PHY, "PHY", 1000.0f / C_TASK_ACQ_FALLBACK_MS);
+    task_prof_register(tlo->task_prof, TASK_PROF_CTL, "CTL", 1000.0f);
+    task_prof_register(tlo->task_prof, TASK_PROF_DIAG, "DIAG", C_TASK_FREQ_DIAG);
 
     TASK_OBJ_NEW(
-        OBJ_MEMBER_SET(can),
+        OBJ_MEMBER_SET(slot),
         OBJ_MEMBER_SET(blink),
-        OBJ_MEMBER_SET(meas),
-        OBJ_MEMBER_SET(phy),
-        OBJ_MEMBER_SET(ctl),
-        OBJ_MEMBER_SET(screen),
+        OBJ_MEMBER_SET(diag),
 
    
     );
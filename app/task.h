@@ -19,12 +19,9 @@
  * 
  *************************************************************************************************/
 TASK_OBJ_STRUCT(
-    TASK_OBJ_STRUCT_MEMBER(can);
+    TASK_OBJ_STRUCT_MEMBER(slot);
     TASK_OBJ_STRUCT_MEMBER(blink);
-    TASK_OBJ_STRUCT_MEMBER(meas);
-    TASK_OBJ_STRUCT_MEMBER(phy);
-    TASK_OBJ_STRUCT_MEMBER(ctl);
-    TASK_OBJ_STRUCT_MEMBER(screen);
+    TASK_OBJ_STRUCT_MEMBER(diag);
 
 );
 
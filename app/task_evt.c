@@ -0,0 +1,72 @@
+/**************************************************************************************************
+ *
+ * \file task_evt.c
+ *
+ * \brief Task activation events implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/task_evt.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * task_evt_new()
+ *
+ *************************************************************************************************/
+struct task_evt *
+task_evt_new(void)
+{
+    static struct task_evt task_evt;
+    memset(&task_evt, 0u, sizeof(struct task_evt));
+
+    return &task_evt;
+}
+
+/**************************************************************************************************
+ *
+ * task_evt_set()
+ *
+ *************************************************************************************************/
+__attribute__((ramfunc)) void
+task_evt_set(struct task_evt *self, uint16_t evt)
+{
+    if (self) {
+        self->flags |= evt;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * task_evt_pending()
+ *
+ *************************************************************************************************/
+bool
+task_evt_pending(const struct task_evt *self, uint16_t mask)
+{
+    return self && ((self->flags & mask) != 0U);
+}
+
+/**************************************************************************************************
+ *
+ * task_evt_take()
+ *
+ *************************************************************************************************/
+uint16_t
+task_evt_take(struct task_evt *self, uint16_t mask)
+{
+    if (!self) {
+        return 0U;
+    }
+
+    uint16_t evt = self->flags & mask;
+
+    /* Only events that were read are cleared, one raised in between stays pending */
+    self->flags &= (uint16_t) ~evt;
+
+    return evt;
+}
@@ -0,0 +1,93 @@
+/**************************************************************************************************
+ *
+ * \file task_evt.h
+ *
+ * \brief Task activation events interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_TASK_EVT_H
+#define _APP_TASK_EVT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Activation events. A job waiting on an event runs in its next slot once the event is raised,
+ * and falls back to its periodic rate otherwise.
+ *
+ *************************************************************************************************/
+enum task_evt_id {
+    TASK_EVT_CAN_RX     = 0x0001U,  /* Frame pushed into the CAN receive ring                   */
+    TASK_EVT_CAN_TX     = 0x0002U,  /* Device request raised (setpoint, on/off, mode, clear)    */
+    TASK_EVT_KEY        = 0x0004U,  /* Edge on the encoder or a front button                    */
+    TASK_EVT_SCREEN     = 0x0008U,  /* Screen refresh requested                                 */
+    TASK_EVT_ACQ        = 0x0010U,  /* ADC acquisition block completed                          */
+};
+
+/**************************************************************************************************
+ *
+ * Task activation events object definition. Flags are 16 bits wide so setting and clearing them
+ * are single read-modify-write instructions and need no critical section.
+ *
+ *************************************************************************************************/
+struct task_evt {
+    volatile uint16_t flags;        /* Pending events (enum task_evt_id)                        */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new task activation events object
+ *
+ * \param None
+ *
+ * \return Task activation events object handler
+ *
+ *************************************************************************************************/
+extern struct task_evt *
+task_evt_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Raises events. May be called from interrupts and from other jobs.
+ *
+ * \param self task activation events object handler; nothing happens if NULL
+ * \param evt events (enum task_evt_id)
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+task_evt_set(struct task_evt *self, uint16_t evt);
+
+/**************************************************************************************************
+ *
+ * \brief Checks if any of the events is pending, without clearing it
+ *
+ * \param self task activation events object handler
+ * \param mask events (enum task_evt_id)
+ *
+ * \return True if any of the events is pending; false otherwise
+ *
+ *************************************************************************************************/
+extern bool
+task_evt_pending(const struct task_evt *self, uint16_t mask);
+
+/**************************************************************************************************
+ *
+ * \brief Clears events and returns those that were pending. Jobs take their events before they
+ * do the work, so an event raised while the work is done is kept for the next run.
+ *
+ * \param self task activation events object handler
+ * \param mask events (enum task_evt_id)
+ *
+ * \return Events that were pending
+ *
+ *************************************************************************************************/
+extern uint16_t
+task_evt_take(struct task_evt *self, uint16_t mask);
+
+#endif /* _APP_TASK_EVT_H */
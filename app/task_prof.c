@@ -0,0 +1,298 @@
+/**************************************************************************************************
+ *
+ * \file task_prof.c
+ *
+ * \brief Task scheduler profiling implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/task_prof.h"
+
+#include "app/tlo.h"
+#include "app/hapi.h"
+#include "app/can_rx.h"
+
+#include "inc/lib/nfo.h"
+#include "inc/net/can.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/** Timestamp ticks per microsecond                                                               */
+#define TASK_PROF_TICKS_US  (HAPI_TIMESTAMP_FREQ / 1000000UL)
+
+/** Statistics window                                                                             */
+#define TASK_PROF_WINDOW    (HAPI_TIMESTAMP_FREQ)
+
+/**************************************************************************************************
+ *
+ * \brief Saturates microseconds to 16 bits
+ *
+ *************************************************************************************************/
+static uint16_t
+task_prof_us16(uint32_t us)
+{
+    return (us > 0xFFFFUL) ? 0xFFFFU : (uint16_t) us;
+}
+
+/**************************************************************************************************
+ *
+ * \brief Closes statistics window
+ *
+ * \param self task profiler object handler
+ * \param now current timestamp
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+static void
+task_prof_window(struct task_prof *self, uint32_t now)
+{
+    uint32_t window = now - self->window_start;
+
+    self->load = (uint16_t) (self->busy / (window / 1000UL));
+    if (self->load > 1000U) {
+        self->load = 1000U;
+    }
+
+    uint16_t i;
+    for (i = 0U; i < TASK_PROF_N; i++) {
+        struct task_prof_job_acc *job = &self->job[i];
+
+        job->stat.runs = job->runs;
+        job->stat.overruns = job->overruns;
+        if (job->runs > 0UL) {
+            job->stat.min = job->min / TASK_PROF_TICKS_US;
+            job->stat.max = job->max / TASK_PROF_TICKS_US;
+            job->stat.mean = (job->sum / job->runs) / TASK_PROF_TICKS_US;
+        } else {
+            job->stat.min = 0UL;
+            job->stat.max = 0UL;
+            job->stat.mean = 0UL;
+        }
+
+        job->min = 0xFFFFFFFFUL;
+        job->max = 0UL;
+        job->sum = 0UL;
+        job->runs = 0UL;
+    }
+
+    self->busy = 0UL;
+    self->window_start = now;
+}
+
+/**************************************************************************************************
+ *
+ * task_prof_new()
+ *
+ *************************************************************************************************/
+struct task_prof *
+task_prof_new(void)
+{
+    static struct task_prof task_prof;
+    memset(&task_prof, 0u, sizeof(struct task_prof));
+
+    uint16_t i;
+    for (i = 0U; i < TASK_PROF_N; i++) {
+        task_prof.job[i].min = 0xFFFFFFFFUL;
+    }
+
+    task_prof.window_start = hapi_timestamp();
+
+    return &task_prof;
+}
+
+/**************************************************************************************************
+ *
+ * task_prof_register()
+ *
+ *************************************************************************************************/
+int
+task_prof_register(struct task_prof *self, enum task_prof_job job, const char *name, float freq)
+{
+    if (!self || job >= TASK_PROF_N || freq <= 0.0f) {
+        return -1;
+    }
+
+    self->job[job].name = name;
+    self->job[job].period = (uint32_t) ((float) HAPI_TIMESTAMP_FREQ / freq);
+
+    return 0;
+}
+
+/**************************************************************************************************
+ *
+ * task_prof_begin()
+ *
+ *************************************************************************************************/
+uint32_t
+task_prof_begin(struct task_prof *self, enum task_prof_job job)
+{
+    uint32_t now = hapi_timestamp();
+
+    if (!self) {
+        return now;
+    }
+
+    struct task_prof_job_acc *acc = &self->job[job];
+
+    /* Missed at least one release */
+    if (acc->started && (now - acc->last_start) >= 2UL * acc->period) {
+        acc->overruns++;
+    }
+
+    acc->last_start = now;
+    acc->started = true;
+
+    return now;
+}
+
+/**************************************************************************************************
+ *
+ * task_prof_end()
+ *
+ *************************************************************************************************/
+void
+task_prof_end(struct task_prof *self, enum task_prof_job job, uint32_t start)
+{
+    uint32_t now = hapi_timestamp();
+
+    if (!self) {
+        return;
+    }
+
+    struct task_prof_job_acc *acc = &self->job[job];
+    uint32_t elapsed = now - start;
+
+    if (elapsed < acc->min) {
+        acc->min = elapsed;
+    }
+    if (elapsed > acc->max) {
+        acc->max = elapsed;
+    }
+    acc->sum += elapsed;
+    acc->runs++;
+
+    if (elapsed > acc->period) {
+        acc->overruns++;
+    }
+
+    self->busy += elapsed;
+
+    if ((now - self->window_start) >= TASK_PROF_WINDOW) {
+        task_prof_window(self, now);
+    }
+}
+
+/**************************************************************************************************
+ *
+ * task_prof_get()
+ *
+ *************************************************************************************************/
+const char *
+task_prof_get(const struct task_prof *self, enum task_prof_job job, struct task_prof_stat *stat)
+{
+    if (!self || job >= TASK_PROF_N || !self->job[job].name) {
+        return NULL;
+    }
+
+    if (stat) {
+        *stat = self->job[job].stat;
+    }
+
+    return self->job[job].name;
+}
+
+/**************************************************************************************************
+ *
+ * task_prof_load()
+ *
+ *************************************************************************************************/
+uint16_t
+task_prof_load(const struct task_prof *self)
+{
+    return self ? self->load : 0U;
+}
+
+/**************************************************************************************************
+ *
+ * task_prof_publish()
+ *
+ *************************************************************************************************/
+int
+task_prof_publish(struct task_prof *self, const struct tlo *tlo)
+{
+    if (!self || !tlo || !tlo->can) {
+        return -1;
+    }
+
+    struct can_f f;
+    const struct nfo *mod = tlo->mod;
+
+    f.id = TASK_PROF_MSG_ID | (((uint32_t) mod->id & 0xFFUL) << 16) |
+        (((uint32_t) mod->address & 0xFFUL) << 24);
+    f.length = 8U;
+    memset(f.data, 0u, sizeof(f.data));
+
+    /* Skip jobs that were never registered */
+    while (self->publish_next < TASK_PROF_N && !self->job[self->publish_next].name) {
+        self->publish_next++;
+    }
+
+    if (self->publish_next < TASK_PROF_N) {
+        const struct task_prof_stat *stat = &self->job[self->publish_next].stat;
+        uint16_t min = task_prof_us16(stat->min);
+        uint16_t max = task_prof_us16(stat->max);
+        uint16_t mean = task_prof_us16(stat->mean);
+
+        f.data[0] = self->publish_next & 0xFFU;
+        f.data[1] = (min >> 8) & 0xFFU;
+        f.data[2] = min & 0xFFU;
+        f.data[3] = (max >> 8) & 0xFFU;
+        f.data[4] = max & 0xFFU;
+        f.data[5] = (mean >> 8) & 0xFFU;
+        f.data[6] = mean & 0xFFU;
+        f.data[7] = (stat->overruns > 0xFFUL) ? 0xFFU : (stat->overruns & 0xFFU);
+
+        self->publish_next++;
+    } else if (self->publish_next > TASK_PROF_N) {
+        /* Written by the receive interrupt, each field is read in one access */
+        uint16_t hwm = tlo->can_rx->hwm;
+        uint32_t overflow = tlo->can_rx->overflow;
+
+        f.data[0] = TASK_PROF_MUX_CAN_RX;
+        f.data[1] = (hwm >> 8) & 0xFFU;
+        f.data[2] = hwm & 0xFFU;
+        f.data[3] = (overflow >> 24) & 0xFFU;
+        f.data[4] = (overflow >> 16) & 0xFFU;
+        f.data[5] = (overflow >>  8) & 0xFFU;
+        f.data[6] = overflow & 0xFFU;
+        f.data[7] = (CAN_RX_SIZE > 0xFFU) ? 0xFFU : CAN_RX_SIZE;
+
+        self->publish_next = 0U;
+    } else {
+        uint32_t overruns = 0UL;
+        uint16_t i;
+        for (i = 0U; i < TASK_PROF_N; i++) {
+            overruns += self->job[i].stat.overruns;
+        }
+
+        f.data[0] = TASK_PROF_MUX_LOAD;
+        f.data[1] = (self->load >> 8) & 0xFFU;
+        f.data[2] = self->load & 0xFFU;
+        f.data[3] = (overruns >> 24) & 0xFFU;
+        f.data[4] = (overruns >> 16) & 0xFFU;
+        f.data[5] = (overruns >>  8) & 0xFFU;
+        f.data[6] = overruns & 0xFFU;
+
+        self->publish_next = tlo->can_rx ? TASK_PROF_N + 1U : 0U;
+    }
+
+    hapi_can_lock(true);
+    int ret = can_write(tlo->can, &f);
+    hapi_can_lock(false);
+
+    return ret;
+}
@@ -0,0 +1,212 @@
+/**************************************************************************************************
+ *
+ * \file task_prof.h
+ *
+ * \brief Task scheduler profiling interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_TASK_PROF_H
+#define _APP_TASK_PROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Forward declarations
+ *
+ *************************************************************************************************/
+
+struct tlo;
+
+/** Diagnostic CAN message ID (own device type and stack are added on top)                       */
+#define TASK_PROF_MSG_ID    (0x7FF0U)
+
+/** Multiplexer value of the CPU load frame                                                       */
+#define TASK_PROF_MUX_LOAD  (0xFFU)
+
+/** Multiplexer value of the CAN receive ring frame                                               */
+#define TASK_PROF_MUX_CAN_RX    (0xFEU)
+
+/**************************************************************************************************
+ *
+ * Profiled scheduler jobs
+ *
+ *************************************************************************************************/
+enum task_prof_job {
+    TASK_PROF_CAN,
+    TASK_PROF_BLINK,
+    TASK_PROF_SCREEN,
+    TASK_PROF_MEAS,
+    TASK_PROF_PHY,
+    TASK_PROF_CTL,
+    TASK_PROF_DIAG,
+    TASK_PROF_N
+};
+
+/**************************************************************************************************
+ *
+ * Job statistics over the last one-second window, in microseconds
+ *
+ *************************************************************************************************/
+struct task_prof_stat {
+    uint32_t min;                   /* Shortest execution time                                  */
+    uint32_t max;                   /* Longest execution time                                   */
+    uint32_t mean;                  /* Mean execution time                                      */
+    uint32_t runs;                  /* Number of runs                                           */
+    uint32_t overruns;              /* Overruns since start-up                                  */
+};
+
+/**************************************************************************************************
+ *
+ * Per-job accumulators (hapi_timestamp() ticks)
+ *
+ *************************************************************************************************/
+struct task_prof_job_acc {
+    const char *name;               /* Job name                                                 */
+    uint32_t period;                /* Job period                                               */
+    uint32_t last_start;            /* Start of previous run                                    */
+    bool started;                   /* False until the first run                                */
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+    uint32_t runs;
+    uint32_t overruns;
+    struct task_prof_stat stat;     /* Published statistics                                     */
+};
+
+/**************************************************************************************************
+ *
+ * Task profiler object definition
+ *
+ *************************************************************************************************/
+struct task_prof {
+    struct task_prof_job_acc job[TASK_PROF_N];
+    uint32_t window_start;          /* Start of current one-second window                       */
+    uint32_t busy;                  /* Ticks spent in jobs in the current window                */
+    uint16_t load;                  /* CPU load over the last window (per mille)                */
+    uint16_t publish_next;          /* Next frame to publish                                    */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Defines a profiled wrapper <callback>_prof around a scheduler job callback. The wrapper
+ * is what gets registered with TASK_JOB_NEW().
+ *
+ * \param job profiled job (enum task_prof_job)
+ * \param callback job callback
+ *
+ *************************************************************************************************/
+#define TASK_PROF_CALLBACK(job, callback)                                                       \
+static void                                                                                     \
+callback##_prof(const struct tlo *tlo)                                                          \
+{                                                                                               \
+    uint32_t start = task_prof_begin(tlo->task_prof, job);                                      \
+    callback(tlo);                                                                              \
+    task_prof_end(tlo->task_prof, job, start);                                                  \
+}
+
+/**************************************************************************************************
+ *
+ * \brief Creates new task profiler object
+ *
+ * \param None
+ *
+ * \return Task profiler object handler
+ *
+ *************************************************************************************************/
+extern struct task_prof *
+task_prof_new(void);
+
+/**************************************************************************************************
+ *
+ * \brief Registers profiled job
+ *
+ * \param self task profiler object handler
+ * \param job profiled job
+ * \param name job name
+ * \param freq job frequency (Hz)
+ *
+ * \return 0 if operation is successful; -1 otherwise
+ *
+ *************************************************************************************************/
+extern int
+task_prof_register(struct task_prof *self, enum task_prof_job job, const char *name, float freq);
+
+/**************************************************************************************************
+ *
+ * \brief Marks start of job run. A run that starts more than one period late counts as overrun.
+ *
+ * \param self task profiler object handler; profiling is skipped if NULL
+ * \param job profiled job
+ *
+ * \return Start timestamp to be passed to task_prof_end()
+ *
+ *************************************************************************************************/
+extern uint32_t
+task_prof_begin(struct task_prof *self, enum task_prof_job job);
+
+/**************************************************************************************************
+ *
+ * \brief Marks end of job run. A run that takes longer than the job period counts as overrun.
+ * Statistics and CPU load are published once per second.
+ *
+ * \param self task profiler object handler; profiling is skipped if NULL
+ * \param job profiled job
+ * \param start start timestamp returned by task_prof_begin()
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+task_prof_end(struct task_prof *self, enum task_prof_job job, uint32_t start);
+
+/**************************************************************************************************
+ *
+ * \brief Reads job statistics, e.g. for the diagnostic display page
+ *
+ * \param self task profiler object handler
+ * \param job profiled job
+ * \param stat Pointer to statistics buffer
+ *
+ * \return Job name; NULL if job is not registered
+ *
+ *************************************************************************************************/
+extern const char *
+task_prof_get(const struct task_prof *self, enum task_prof_job job, struct task_prof_stat *stat);
+
+/**************************************************************************************************
+ *
+ * \brief Returns CPU load over the last one-second window
+ *
+ * \param self task profiler object handler
+ *
+ * \return CPU load (per mille)
+ *
+ *************************************************************************************************/
+extern uint16_t
+task_prof_load(const struct task_prof *self);
+
+/**************************************************************************************************
+ *
+ * \brief Sends next diagnostic frame. Frames cycle through the jobs, the CPU load frame and,
+ * if the CAN receive ring exists, the ring frame.
+ *
+ * Job frame:  [0] job, [1:2] min (us), [3:4] max (us), [5:6] mean (us), [7] overruns (saturated)
+ * Load frame: [0] TASK_PROF_MUX_LOAD, [1:2] load (per mille), [3:6] total overruns
+ * Ring frame: [0] TASK_PROF_MUX_CAN_RX, [1:2] high-water mark (frames), [3:6] frames dropped,
+ *             [7] ring size (frames)
+ *
+ * \param self task profiler object handler
+ * \param tlo top-level object handler
+ *
+ * \return 0 if operation is successful; -1 otherwise
+ *
+ *************************************************************************************************/
+extern int
+task_prof_publish(struct task_prof *self, const struct tlo *tlo);
+
+#endif /* _APP_TASK_PROF_H */
@@ -0,0 +1,74 @@
+/**************************************************************************************************
+ *
+ * \file task_slot.c
+ *
+ * \brief Phase-offset job slots implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/task_slot.h"
+
+#include "app/task_evt.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * task_slot_new()
+ *
+ *************************************************************************************************/
+struct task_slot *
+task_slot_new(const struct task_slot_job *job, uint16_t n)
+{
+    if (!job || n == 0U || n > TASK_SLOT_MAX) {
+        return NULL;
+    }
+
+    static struct task_slot task_slot;
+    memset(&task_slot, 0u, sizeof(struct task_slot));
+
+    task_slot.job = job;
+    task_slot.n = n;
+
+    return &task_slot;
+}
+
+/**************************************************************************************************
+ *
+ * task_slot_run()
+ *
+ *************************************************************************************************/
+bool
+task_slot_run(struct task_slot *self, const struct task_evt *evt, const struct tlo *tlo)
+{
+    uint16_t slot = self->slot;
+    const struct task_slot_job *job = &self->job[slot];
+    bool run;
+
+    if (++self->slot >= self->n) {
+        self->slot = 0U;
+    }
+
+    if (task_evt_pending(evt, job->evt)) {
+        self->hold[slot] = job->hold;
+        run = true;
+    } else if (self->hold[slot] > 0U) {
+        self->hold[slot]--;
+        run = true;
+    } else {
+        run = (++self->idle[slot] >= job->fallback);
+    }
+
+    if (!run) {
+        self->skipped++;
+        return false;
+    }
+
+    self->idle[slot] = 0U;
+    job->callback(tlo);
+
+    return true;
+}
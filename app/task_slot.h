@@ -0,0 +1,84 @@
+/**************************************************************************************************
+ *
+ * \file task_slot.h
+ *
+ * \brief Phase-offset job slots interface
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _APP_TASK_SLOT_H
+#define _APP_TASK_SLOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Forward declarations
+ *
+ *************************************************************************************************/
+
+struct tlo;
+struct task_evt;
+
+/** Maximum number of jobs sharing the slot task                                                  */
+#define TASK_SLOT_MAX       (8U)
+
+/**************************************************************************************************
+ *
+ * Slot job. A job with activation events runs when one of them is raised, and at its fallback
+ * period otherwise. Periods are counted in full rounds of the slot table.
+ *
+ *************************************************************************************************/
+struct task_slot_job {
+    void (*callback)(const struct tlo *tlo);
+    uint16_t evt;                   /* Activation events (enum task_evt_id)                     */
+    uint16_t fallback;              /* Period when no event is raised (rounds)                  */
+    uint16_t hold;                  /* Job runs every round for this long after an event        */
+};
+
+/**************************************************************************************************
+ *
+ * Slot dispatcher object definition
+ *
+ *************************************************************************************************/
+struct task_slot {
+    const struct task_slot_job *job;
+    uint16_t n;                     /* Number of jobs                                           */
+    uint16_t slot;                  /* Next slot                                                */
+    uint16_t idle[TASK_SLOT_MAX];   /* Rounds since last run                                    */
+    uint16_t hold[TASK_SLOT_MAX];   /* Rounds left to run after an event                        */
+    uint32_t skipped;               /* Slots skipped because the job had nothing to do          */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Creates new slot dispatcher object
+ *
+ * \param job slot jobs, one per slot, in dispatch order
+ * \param n number of jobs, at most TASK_SLOT_MAX
+ *
+ * \return Slot dispatcher object handler; NULL if job table is invalid
+ *
+ *************************************************************************************************/
+extern struct task_slot *
+task_slot_new(const struct task_slot_job *job, uint16_t n);
+
+/**************************************************************************************************
+ *
+ * \brief Runs next slot. The slot task calls this n times per round, so equal-rate jobs are
+ * spread evenly over the round instead of running back-to-back.
+ *
+ * \param self slot dispatcher object handler
+ * \param evt task activation events object handler
+ * \param tlo top-level object handler, passed on to the job
+ *
+ * \return True if the job ran; false if it skipped its slot
+ *
+ *************************************************************************************************/
+extern bool
+task_slot_run(struct task_slot *self, const struct task_evt *evt, const struct tlo *tlo);
+
+#endif /* _APP_TASK_SLOT_H */
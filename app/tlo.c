@@ -19,6 +19,18 @@
 #include "app/wcs.h"
 #include "app/dev_ctl.h"
 #include "app/superset_ctl.h"
+#include "app/can_filter.h"
+#include "app/can_rx.h"
+#include "app/can_tx.h"
+#include "app/task_prof.h"
+#include "app/screen.h"
+#include "app/cell.h"
+#include "app/page.h"
+#include "app/task_evt.h"
+#include "app/acq.h"
+#include "app/ipc_queue.h"
+#include "app/dev_snap.h"
+#include "app/hapi.h"
 
 
 
@@ -47,8 +59,10 @@
 
 
 
-/** For this application, we want to listen to temperature messages from other modules
- * so we set the CAN mask to 0 so that the hardware does not filter them out */
+/** For this application, we want to listen to messages from other modules so the CAN
+ * mask is set to 0. The CAN filter manager takes the device type broadcasts off fw_lib's
+ * message objects, and narrows them to the devices present outside the sniffer states,
+ * see app/can_filter.h */
 #define CAN_MASK (0)
 /**************************************************************************************************
  * 
@@ -68,16 +82,25 @@ tlo_new(void)
         .db_vg11_fm01 = NULL,
         .db_vg11_fm02 = NULL,
         .adc  = NULL,
+        .acq  = NULL,
         .ctl  = NULL,
         .task = NULL,
+        .task_prof = NULL,
+        .task_evt = NULL,
         //.wcs = NULL,
         .dlog = NULL,
         .dlog_db = NULL,
         .logging_db = NULL,
         .keys = NULL,
         .state_machine = NULL,
+        .screen = NULL,
         .dev_ctl = NULL,
+        .dev_snap = NULL,
+        .ui_cmd = NULL,
         .superset_ctl = NULL,
+        .can_filter = NULL,
+        .can_rx = NULL,
+        .can_tx = NULL,
 
 
 
@@ -113,6 +136,14 @@ tlo_new(void)
     
     tlo.dev_ctl = dev_ctl_new(&tlo);
     tlo.superset_ctl = superset_ctl_new(&tlo);
+    tlo.can_tx = can_tx_new(&tlo);
+
+    /**
+     * The user interface only sees the registry through the snapshot and only changes it
+     * through the request queue, so it can run on the other core.
+     */
+    tlo.dev_snap = dev_snap_new();
+    tlo.ui_cmd = ipc_queue_new();
 
 
 
@@ -121,11 +152,49 @@ tlo_new(void)
 
     //tlo.ctl = ctl_new(tlo.adc, tlo.fan_ctl);
 
+    /* Events are raised from interrupts, so they must exist before any is enabled */
+    tlo.task_evt = task_evt_new();
+
+    /* ADC blocks are filled in the ADC interrupt and processed by the PHY job */
+    tlo.acq = acq_new();
+    acq_notify(tlo.acq, tlo.task_evt);
+
+    /**
+     * The CLA acquires and filters on its own where enabled. Otherwise blocks are moved by DMA
+     * where available, and the per-sample ADC interrupt is the fallback.
+     */
+    #if defined(CLA_OFFLOAD)
+    if (hapi_cla_enable() == 0) {
+        acq_cla(tlo.acq);
+    }
+    #endif
+    if (!tlo.acq->cla) {
+        tlo.acq->dma = (hapi_adc_dma_enable(tlo.acq) == 0);
+    }
+
+    /* Profiler must exist before the jobs are registered */
+    tlo.task_prof = task_prof_new();
     tlo.task = task_new(&tlo);
 
+    tlo.screen = screen_new();
+    tlo.cells = cell_page_new();
+    tlo.page = page_new();
     tlo.keys = key_new(&tlo);
     tlo.state_machine = state_machine_new(&tlo);
 
+    /* Application message objects sit below fw_lib's, so they are set up after init() */
+    tlo.can_filter = can_filter_new(&tlo);
+
+    /* Frames are received in the CAN interrupt and consumed by the CAN task */
+    tlo.can_rx = can_rx_new();
+    can_rx_notify(tlo.can_rx, tlo.task_evt);
+    if (hapi_can_rx_enable(tlo.can_rx) < 0) {
+        tlo.can_rx = NULL;
+    }
+
+    /* Encoder and button edges wake the key job up */
+    hapi_key_irq_enable(tlo.task_evt);
+
 
 
     /* FP  database */
@@ -174,7 +243,7 @@ tlo_new(void)
 
   
 
-    alert_set(ALERT_SYSTEM, !(tlo.adc && tlo.task && tlo.dev_ctl &&tlo.db ));
+    alert_set(ALERT_SYSTEM, !(tlo.adc && tlo.task && tlo.dev_ctl &&tlo.db && tlo.can_filter && tlo.can_rx && tlo.can_tx));
     
     return &tlo;
 }
@@ -29,6 +29,17 @@ struct ctl;
 struct dlog;
 struct logging;
 struct supervisor;
+struct can_filter;
+struct can_rx;
+struct can_tx;
+struct task_prof;
+struct screen;
+struct task_evt;
+struct acq;
+struct ipc_queue;
+struct dev_snap;
+struct cell_page;
+struct page;
 
 struct adm_cs_fp_db;
 struct adm_pc_bp25_db;
@@ -56,11 +67,19 @@ struct tlo {
     const struct adm_pc_vg11_fm01_db *db_vg11_fm01;
     const struct adm_pc_vg11_fm02_db *db_vg11_fm02;
     const struct adc *adc;
+    struct acq *acq;
     struct ctl *ctl;
     const struct task *task;
+    struct task_prof *task_prof;
+    struct task_evt *task_evt;
     //const struct wcs *wcs;
     struct dev_ctl *dev_ctl;
+    struct dev_snap *dev_snap;
+    struct ipc_queue *ui_cmd;
     const struct superset_ctl *superset_ctl;
+    struct can_filter *can_filter;
+    struct can_rx *can_rx;
+    struct can_tx *can_tx;
     const struct dlog *dlog;
     const struct dlog_db *dlog_db;
     const struct logging *logging;
@@ -70,6 +89,9 @@ struct tlo {
 
     struct keys *keys;
     struct state_machine *state_machine;
+    struct screen *screen;
+    struct cell_page *cells;
+    struct page *page;
 
 
 };
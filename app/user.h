@@ -27,6 +27,21 @@
 #define C_TASK_FREQ_CAL     ((float) 1000.0f)   /* ADC and WCH calibration task frequency (Hz)  */
 #define C_TASK_FREQ_MLX_MEAS     ((float) 30.0f)   /* ADC and WCH calibration task frequency (Hz)  */
 #define C_TASK_FREQ_MLX     ((float) 2.0f)   /* ADC and WCH calibration task frequency (Hz)  */
+#define C_TASK_FREQ_DIAG    ((float) 10.0f)     /* Scheduler diagnostics task frequency (Hz)    */
+#define C_TASK_SLOTS        (5U)                /* Number of 1 kHz jobs sharing the slot task   */
+#define C_TASK_FREQ_SLOT    ((float) 5000.0f)   /* Slot task frequency, C_TASK_SLOTS kHz (Hz)   */
+
+/**************************************************************************************************
+ * 
+ * Fallback periods of event-driven jobs (ms). A job runs in its next slot once its event is
+ * raised, and at the fallback period when nothing happens.
+ * 
+ *************************************************************************************************/
+#define C_TASK_CAN_FALLBACK_MS  (1U)    /* fw_lib's receive objects are polled by db_run()      */
+#define C_TASK_KEY_FALLBACK_MS  (10U)   /* Key sampling without key edges (button_cw)           */
+#define C_TASK_KEY_HOLD_MS      (50U)   /* Key sampling stays at 1 kHz this long after an edge  */
+#define C_TASK_ACQ_FALLBACK_MS  (10U)   /* ADC block processing, a block takes 6.4 ms to fill   */
+#define C_TASK_SNAP_MS          (20U)   /* Device registry snapshot for the user interface      */
 
 
 /**************************************************************************************************
@@ -0,0 +1,134 @@
+/**************************************************************************************************
+ *
+ * \file dev_ctl_bench.c
+ *
+ * \brief Device registry lookup benchmark. A full registry is refreshed by device type
+ * broadcasts and searched by (id, stack), against the linear scans the index replaced. Prints
+ * the time per operation; numbers are for comparison on one machine only.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/dev_ctl.h"
+#include "app/display/state_machine.h"
+
+#include "hapi_sim.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ROUNDS    (2000U)
+
+static struct state_machine state_machine;
+static struct tlo tlo;
+static volatile int sink;
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+static struct can_f
+broadcast(enum nfo_id id, uint8_t stack, uint32_t serial_number)
+{
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = ((uint32_t) stack << 24) | ((uint32_t) id << 16) | 0x8000UL;
+    f.length = 8U;
+    f.data[4] = (serial_number >> 24) & 0xFFU;
+    f.data[5] = (serial_number >> 16) & 0xFFU;
+    f.data[6] = (serial_number >>  8) & 0xFFU;
+    f.data[7] = (serial_number >>  0) & 0xFFU;
+    return f;
+}
+
+/** Lookups as they were before the index: one pass over every slot                              */
+static int
+linear_find_sn(const struct dev_ctl *self, uint32_t serial_number)
+{
+    int i;
+    for (i = 0; i < N_DEVICES; i++) {
+        if (self->can_dev[i].id != 0 && self->can_dev[i].serial_number == serial_number) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int
+linear_find(const struct dev_ctl *self, enum nfo_id id, uint8_t stack)
+{
+    int i;
+    for (i = 0; i < N_DEVICES; i++) {
+        if (self->can_dev[i].id == id && self->can_dev[i].stack == stack) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void
+report(const char *name, double ns, unsigned ops)
+{
+    printf("%-32s %8.1f ns/op\n", name, ns / (double) ops);
+}
+
+int
+main(void)
+{
+    hapi_sim_reset();
+    state_machine.currentState = state_sniffer_stack;
+    tlo.state_machine = &state_machine;
+    tlo.dev_ctl = dev_ctl_new(&tlo);
+
+    struct can_f f[N_DEVICES];
+    uint16_t i;
+    for (i = 0U; i < N_DEVICES; i++) {
+        /* Serial numbers of one production batch only differ in the low bits */
+        f[i] = broadcast((i & 1U) ? NFO_VG11_FM01 : NFO_BP25, (uint8_t) i, 0x21400000UL + i);
+        (void) dev_ctl_update_devices(&tlo, &f[i]);
+    }
+
+    unsigned ops = BENCH_ROUNDS * N_DEVICES;
+    unsigned n;
+    double t;
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        for (i = 0U; i < N_DEVICES; i++) {
+            sink += dev_ctl_update_devices(&tlo, &f[i]);
+        }
+    }
+    report("broadcast refresh", now_ns() - t, ops);
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        for (i = 0U; i < N_DEVICES; i++) {
+            sink += linear_find_sn(tlo.dev_ctl, 0x21400000UL + i);
+        }
+    }
+    report("serial number, linear scan", now_ns() - t, ops);
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        for (i = 0U; i < N_DEVICES; i++) {
+            sink += dev_ctl_find(tlo.dev_ctl, (i & 1U) ? NFO_VG11_FM01 : NFO_BP25, (uint8_t) i);
+        }
+    }
+    report("(id, stack), index", now_ns() - t, ops);
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        for (i = 0U; i < N_DEVICES; i++) {
+            sink += linear_find(tlo.dev_ctl, (i & 1U) ? NFO_VG11_FM01 : NFO_BP25, (uint8_t) i);
+        }
+    }
+    report("(id, stack), linear scan", now_ns() - t, ops);
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**************************************************************************************************
+ *
+ * \file display_bench.c
+ *
+ * \brief Display report on the virtual clock. Runs the application with a device on its main
+ * view against the simulated SSD1322, steps through a few page changes and prints, per page,
+ * the renders, the bytes sent to the display, the DMA transfers and the time from the change
+ * until the last byte was on the panel. The panel read back from the controller model must match
+ * the frame drawn, otherwise the page is reported as a mismatch and the exit status is 1. With
+ * out= every page is also saved as a PGM snapshot, e.g.
+ *
+ *   display_bench out=snapshots/page spi_byte=1
+ *
+ * Costs are in microseconds per byte, as for task_bench. Draw times of the page renderer itself
+ * are measured on the host clock; numbers are for comparison on one machine only.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/tlo.h"
+#include "app/page.h"
+#include "app/screen.h"
+#include "app/can_filter.h"
+#include "app/task_evt.h"
+#include "app/dev_ctl.h"
+#include "app/display/state_machine.h"
+
+#include "hapi_sim.h"
+#include "net_sim.h"
+#include "task_sim.h"
+#include "ssd1322_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TICKS_US    (HAPI_TIMESTAMP_FREQ / 1000000UL)
+#define TICKS_MS    (HAPI_TIMESTAMP_FREQ / 1000UL)
+
+/**
+ * Time given to each page change (ms). Devices are only heard from while the state machine looks
+ * for them, so all pages must be through before the device times out (DEV_CTL_ALIVE_TIMEOUT_MS).
+ */
+#define BENCH_PAGE_MS   (300UL)
+
+#define BENCH_ROUNDS    (2000U)
+
+static const struct tlo *tlo;
+static const char *out;
+static unsigned mismatches;
+static uint8_t panel[SCREEN_BUF_SIZE];
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+/** Prints what a page took since the counters were read, checks and saves the panel             */
+static void
+report(const char *name, const struct hapi_sim_spi *before, uint32_t start, uint32_t renders)
+{
+    static unsigned n = 0U;
+    const struct hapi_sim_spi *spi = hapi_sim_spi();
+
+    bool page = (tlo->page->dev >= 0);
+    bool match = true;
+    if (page) {
+        ssd1322_sim_panel(panel);
+        match = (memcmp(panel, tlo->page->buf, sizeof(panel)) == 0);
+    }
+    if (!match) {
+        mismatches++;
+    }
+
+    /* Nothing sent, nothing to wait for */
+    uint32_t time = (spi->last != before->last) ? spi->last - start : 0UL;
+
+    printf("%-8s %3u renders %6u cmd bytes %6u data bytes %6u DMA bytes %5u transfers %9.1f us%s\n",
+        name, (unsigned) (tlo->screen->renders - renders),
+        (unsigned) (spi->cmd_bytes - before->cmd_bytes),
+        (unsigned) (spi->data_bytes - before->data_bytes),
+        (unsigned) (spi->dma_bytes - before->dma_bytes),
+        (unsigned) (spi->transfers - before->transfers),
+        (double) time / (double) TICKS_US,
+        match ? "" : "  MISMATCH");
+
+    if (out) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s_%02u_%s.pgm", out, n, name);
+        if (ssd1322_sim_pgm(path) < 0) {
+            fprintf(stderr, "%s: cannot write\n", path);
+        }
+    }
+    n++;
+}
+
+/** Steps through a page change: change, BENCH_PAGE_MS of running, report                      */
+#define PAGE(name, change)                                                                      \
+    do {                                                                                        \
+        struct hapi_sim_spi before = *hapi_sim_spi();                                           \
+        uint32_t start = hapi_timestamp();                                                      \
+        uint32_t renders = tlo->screen->renders;                                                \
+        change;                                                                                 \
+        task_sim_run(BENCH_PAGE_MS * TICKS_MS);                                                 \
+        report(name, &before, start, renders);                                                  \
+    } while (0)
+
+/** Times the page renderer alone, drawing the whole page or one cell                           */
+static void
+draw_times(void)
+{
+    struct page *page = tlo->page;
+    struct cell_page *cells = tlo->cells;
+    unsigned n;
+    double t;
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        page->dev = -1;
+        (void) page_draw(page, cells, tlo->dev_snap);
+    }
+    printf("%-32s %8.1f ns\n", "page_draw, whole page", (now_ns() - t) / BENCH_ROUNDS);
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        cells->cell[0].dirty = true;
+        (void) page_draw(page, cells, tlo->dev_snap);
+    }
+    printf("%-32s %8.1f ns\n", "page_draw, one cell", (now_ns() - t) / BENCH_ROUNDS);
+}
+
+int
+main(int argc, char *argv[])
+{
+    hapi_sim_reset();
+    net_sim_reset();
+    hapi_sim_cost(HAPI_SIM_SCREEN_BYTE, 1U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_SPI_BYTE, 1U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_RENDER, 1500U * TICKS_US);
+
+    int arg;
+    for (arg = 1; arg < argc; arg++) {
+        const char *eq = strchr(argv[arg], '=');
+        if (!eq) {
+            fprintf(stderr, "%s: expected name=value\n", argv[arg]);
+            return 1;
+        }
+
+        size_t len = (size_t) (eq - argv[arg]);
+        unsigned value = (unsigned) strtoul(eq + 1, NULL, 10);
+
+        if (len == 3U && strncmp(argv[arg], "out", len) == 0) {
+            out = eq + 1;
+        } else if (len == 11U && strncmp(argv[arg], "screen_byte", len) == 0) {
+            hapi_sim_cost(HAPI_SIM_SCREEN_BYTE, value * TICKS_US);
+        } else if (len == 8U && strncmp(argv[arg], "spi_byte", len) == 0) {
+            hapi_sim_cost(HAPI_SIM_SPI_BYTE, value * TICKS_US);
+        } else {
+            fprintf(stderr, "%s: unknown parameter\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    tlo = tlo_new();
+    if (!tlo || !tlo->page) {
+        fprintf(stderr, "tlo_new() failed\n");
+        return 1;
+    }
+
+    /* A BP25 at stack 3 announces itself while the state machine looks for devices */
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = (3UL << 24) | ((uint32_t) NFO_BP25 << 16) | CAN_FILTER_ID_DEV_TYPE;
+    f.length = 8U;
+    f.data[7] = 1U;
+    (void) hapi_sim_can_receive(&f);
+    task_sim_run(100U * TICKS_MS);
+
+    struct can_dev *dev = &tlo->dev_ctl->can_dev[0];
+    if (!dev->present) {
+        fprintf(stderr, "device did not register\n");
+        return 1;
+    }
+
+    const int *m = dev->custom_mesurables;
+    dev->mesurables[m[0]] = 1.0;
+    dev->mesurables[m[1]] = 230.4;
+    dev->mesurables[m[2]] = 12.5;
+    dev->mesurables[m[3]] = 2880.0;
+    if (dev->ops && dev->ops->temp >= 0) {
+        dev->mesurables[dev->ops->temp] = 41.0;
+    }
+
+    /* Values are in the snapshot well before the page is opened */
+    task_sim_run(100U * TICKS_MS);
+
+    /* Page changes come with key input, which asks for a render right away */
+    PAGE("main", {
+        tlo->state_machine->currentState = state_main;
+        task_evt_set(tlo->task_evt, TASK_EVT_SCREEN);
+    });
+    PAGE("idle", (void) 0);
+    PAGE("one", dev->mesurables[m[2]] = 12.75);
+    PAGE("all", {
+        dev->mesurables[m[0]] = 0.0;
+        dev->mesurables[m[1]] = 229.1;
+        dev->mesurables[m[2]] = 13.0;
+        dev->mesurables[m[3]] = 2990.0;
+        if (dev->ops && dev->ops->temp >= 0) {
+            dev->mesurables[dev->ops->temp] = 43.5;
+        }
+    });
+    PAGE("leave", {
+        tlo->state_machine->currentState = state_select_superset;
+        task_evt_set(tlo->task_evt, TASK_EVT_SCREEN);
+    });
+    PAGE("return", {
+        tlo->state_machine->currentState = state_main;
+        task_evt_set(tlo->task_evt, TASK_EVT_SCREEN);
+    });
+
+    draw_times();
+
+    if (mismatches > 0U) {
+        printf("%u pages differ from the frame drawn\n", mismatches);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**************************************************************************************************
+ *
+ * \file fmt_bench.c
+ *
+ * \brief Display number formatting benchmark. Random values in the ranges the device pages show
+ * are formatted with fmt_float() and with snprintf(), as the display did before. Prints the
+ * time per value; numbers are for comparison on one machine only, the target has no hardware
+ * division and a much slower soft-float printf.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/fmt.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_VALUES    (4096U)
+#define BENCH_ROUNDS    (200U)
+#define BENCH_WIDTH     (8U)
+
+static float value[BENCH_VALUES];
+static uint16_t decimals[BENCH_VALUES];
+static volatile unsigned sink;
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+static void
+report(const char *name, double ns, unsigned ops)
+{
+    printf("%-32s %8.1f ns/value\n", name, ns / (double) ops);
+}
+
+int
+main(void)
+{
+    char buf[FMT_WIDTH_MAX + 8U];
+    unsigned ops = BENCH_VALUES * BENCH_ROUNDS;
+    unsigned n;
+    uint16_t i;
+    double t;
+
+    /* Voltages, currents and powers: up to 1000 with 0 to 2 decimals, either sign */
+    srand(1U);
+    for (i = 0U; i < BENCH_VALUES; i++) {
+        value[i] = ((float) rand() / (float) RAND_MAX - 0.5f) * 2000.0f;
+        decimals[i] = (uint16_t) (rand() % 3);
+    }
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        for (i = 0U; i < BENCH_VALUES; i++) {
+            sink += fmt_float(buf, BENCH_WIDTH, value[i], decimals[i], "V");
+        }
+    }
+    report("fmt_float", now_ns() - t, ops);
+
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        for (i = 0U; i < BENCH_VALUES; i++) {
+            sink += (unsigned) snprintf(buf, sizeof(buf), "%*.*f%s", (int) BENCH_WIDTH,
+                (int) decimals[i], (double) value[i], "V");
+        }
+    }
+    report("snprintf", now_ns() - t, ops);
+
+    /* Cell refresh: the value is only formatted when it moved to another display step */
+    t = now_ns();
+    for (n = 0U; n < BENCH_ROUNDS; n++) {
+        for (i = 0U; i < BENCH_VALUES; i++) {
+            sink += (unsigned) fmt_scale(value[i], decimals[i]);
+        }
+    }
+    report("fmt_scale (step check only)", now_ns() - t, ops);
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**************************************************************************************************
+ *
+ * \file task_bench.c
+ *
+ * \brief Scheduler report on the virtual clock. Runs the application for a while with the call
+ * costs given on the command line and prints start jitter, deadline misses and CPU share per
+ * job, e.g.
+ *
+ *   task_bench render=2500 db_run=8 rx=4 seconds=5
+ *
+ * Costs are in microseconds per call (per byte for screen_byte and spi_byte), rx is the number
+ * of frames fw_lib's objects receive per millisecond.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/tlo.h"
+
+#include "hapi_sim.h"
+#include "net_sim.h"
+#include "task_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TICKS_US    (HAPI_TIMESTAMP_FREQ / 1000000UL)
+#define TICKS_MS    (HAPI_TIMESTAMP_FREQ / 1000UL)
+
+static const struct {
+    const char *name;
+    enum hapi_sim_call call;
+    uint32_t us;                    /* Default cost                                             */
+} cost[] = {
+    { "screen_byte",    HAPI_SIM_SCREEN_BYTE,   1U },
+    { "spi_byte",       HAPI_SIM_SPI_BYTE,      1U },
+    { "can_read",       HAPI_SIM_CAN_READ,      1U },
+    { "can_write",      HAPI_SIM_CAN_WRITE,     2U },
+    { "db_run",         HAPI_SIM_DB_RUN,        5U },
+    { "key_read",       HAPI_SIM_KEY_READ,      2U },
+    { "render",         HAPI_SIM_RENDER,        1500U },
+};
+
+#define COSTS   (sizeof(cost) / sizeof(cost[0]))
+
+int
+main(int argc, char *argv[])
+{
+    unsigned seconds = 2U;
+    unsigned rx = 0U;
+
+    hapi_sim_reset();
+    net_sim_reset();
+
+    unsigned i;
+    for (i = 0U; i < COSTS; i++) {
+        hapi_sim_cost(cost[i].call, cost[i].us * TICKS_US);
+    }
+
+    int arg;
+    for (arg = 1; arg < argc; arg++) {
+        const char *eq = strchr(argv[arg], '=');
+        if (!eq) {
+            fprintf(stderr, "%s: expected name=value\n", argv[arg]);
+            return 1;
+        }
+
+        size_t len = (size_t) (eq - argv[arg]);
+        unsigned value = (unsigned) strtoul(eq + 1, NULL, 10);
+
+        if (len == 7U && strncmp(argv[arg], "seconds", len) == 0) {
+            seconds = value;
+            continue;
+        }
+        if (len == 2U && strncmp(argv[arg], "rx", len) == 0) {
+            rx = value;
+            continue;
+        }
+
+        for (i = 0U; i < COSTS; i++) {
+            if (strlen(cost[i].name) == len && strncmp(argv[arg], cost[i].name, len) == 0) {
+                hapi_sim_cost(cost[i].call, value * TICKS_US);
+                break;
+            }
+        }
+        if (i == COSTS) {
+            fprintf(stderr, "%s: unknown cost\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (!tlo_new()) {
+        fprintf(stderr, "tlo_new() failed\n");
+        return 1;
+    }
+
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = 0x01100001UL;
+    f.length = 8U;
+
+    unsigned ms;
+    for (ms = 0U; ms < seconds * 1000U; ms++) {
+        for (i = 0U; i < rx; i++) {
+            (void) net_sim_rx(&f);
+        }
+        task_sim_run(TICKS_MS);
+    }
+
+    task_sim_report();
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+/**************************************************************************************************
+ *
+ * \file check.h
+ *
+ * \brief Minimal assertion helpers for host tests. A failed check is reported and counted, the
+ * test goes on; CHECK_RESULT() is the exit status for ctest.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_SIM_CHECK_H
+#define _HOST_SIM_CHECK_H
+
+#include <stdio.h>
+
+static unsigned check_failures = 0U;
+
+#define CHECK(cond)                                                                             \
+    do {                                                                                        \
+        if (!(cond)) {                                                                          \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);                     \
+            check_failures++;                                                                   \
+        }                                                                                       \
+    } while (0)
+
+#define CHECK_RESULT()  ((check_failures == 0U) ? 0 : 1)
+
+#endif /* _HOST_SIM_CHECK_H */
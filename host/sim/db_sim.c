@@ -0,0 +1,77 @@
+/**************************************************************************************************
+ *
+ * \file db_sim.c
+ *
+ * \brief Simulated fw_lib CAN databases. db_run() reads every queued frame, hands it to the
+ * exception filter and sends one frame for each subscribed database, taking the virtual time
+ * set for those calls.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "inc/api/db.h"
+#include "inc/net/can.h"
+
+#include "hapi_sim.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static struct {
+    bool (*filter)(const struct db_priv *db_priv, const struct can_f *f);
+    const struct db *filter_db;
+} sim;
+
+void
+db_run(const struct net *net, const struct db *db[], uint16_t n)
+{
+    struct can_f f;
+
+    hapi_sim_charge(HAPI_SIM_DB_RUN, n);
+
+    while (can_read(net, &f) > 0) {
+        if (sim.filter && sim.filter_db) {
+            (void) sim.filter(&sim.filter_db->priv, &f);
+        }
+    }
+
+    uint16_t i;
+    for (i = 0U; i < n; i++) {
+        if (db[i] && db[i]->subscribed) {
+            memset(&f, 0u, sizeof(f));
+            f.id = ((uint32_t) db[i]->address << 24) | ((uint32_t) db[i]->id << 16);
+            f.length = 8U;
+            (void) can_write(net, &f);
+        }
+    }
+}
+
+void
+db_subscribe(const struct db *db, uint16_t id, uint16_t address, uint16_t mask)
+{
+    if (!db) {
+        return;
+    }
+
+    struct db *self = (struct db *) db;
+    self->subscribed = true;
+    self->id = id;
+    self->address = address & mask;
+}
+
+void
+db_unsubscribe(const struct db *db)
+{
+    if (db) {
+        ((struct db *) db)->subscribed = false;
+    }
+}
+
+void
+db_add_exception_filter(bool (*filter)(const struct db_priv *db_priv, const struct can_f *f),
+        const struct db *db)
+{
+    sim.filter = filter;
+    sim.filter_db = db;
+}
@@ -0,0 +1,386 @@
+/**************************************************************************************************
+ *
+ * \file hapi_sim.c
+ *
+ * \brief Simulated hardware application interface implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "hapi_sim.h"
+#include "ssd1322_sim.h"
+
+#include "app/can_rx.h"
+#include "app/task_evt.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/**************************************************************************************************
+ *
+ * Simulated hardware state
+ *
+ *************************************************************************************************/
+static struct {
+    uint32_t now;                                   /* Virtual clock                            */
+    struct hapi_sim_can_obj obj[HAPI_CAN_OBJECTS];  /* CAN message objects 1..HAPI_CAN_OBJECTS  */
+    struct can_rx *can_rx;                          /* Receive interrupt enabled if set         */
+    bool can_locked;                                /* Receive interrupt held off               */
+    uint32_t cost[HAPI_SIM_CALLS];                  /* Virtual time per call or byte            */
+    struct task_evt *key_evt;                       /* Key interrupts enabled if set            */
+    struct hapi_sim_spi spi;                        /* Display SPI sink counters                */
+    bool spi_active;                                /* DMA transfer in progress                 */
+    uint32_t spi_end;                               /* End of DMA transfer                      */
+    const uint8_t *spi_data;                        /* Bytes being sent by DMA                  */
+    uint16_t spi_length;
+    void (*spi_done)(void *ctx);                    /* DMA completion callback                  */
+    void *spi_ctx;
+} sim;
+
+/**************************************************************************************************
+ *
+ * \brief Receive interrupt model: reads the application objects that hold a frame, lowest first
+ *
+ *************************************************************************************************/
+static void
+hapi_sim_can_isr(void)
+{
+    uint16_t i;
+    for (i = 0U; i < HAPI_CAN_OBJECTS; i++) {
+        struct hapi_sim_can_obj *obj = &sim.obj[i];
+        if (obj->valid && obj->ie && obj->newdat) {
+            obj->newdat = false;
+            (void) can_rx_push(sim.can_rx, &obj->f, sim.now);
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_reset()
+ *
+ *************************************************************************************************/
+void
+hapi_sim_reset(void)
+{
+    memset(&sim, 0u, sizeof(sim));
+    ssd1322_sim_reset();
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_advance()
+ *
+ *************************************************************************************************/
+void
+hapi_sim_advance(uint32_t ticks)
+{
+    uint32_t end = sim.now + ticks;
+
+    /* DMA completion interrupts fire on time, and may start the next transfer */
+    while (sim.spi_active && (int32_t) (end - sim.spi_end) >= 0) {
+        sim.now = sim.spi_end;
+        sim.spi_active = false;
+        ssd1322_sim_write(sim.spi_data, sim.spi_length, false);
+        sim.spi.last = sim.now;
+        if (sim.spi_done) {
+            sim.spi_done(sim.spi_ctx);
+        }
+    }
+
+    sim.now = end;
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_cost()
+ *
+ *************************************************************************************************/
+void
+hapi_sim_cost(enum hapi_sim_call call, uint32_t ticks)
+{
+    if (call < HAPI_SIM_CALLS) {
+        sim.cost[call] = ticks;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_charge()
+ *
+ *************************************************************************************************/
+void
+hapi_sim_charge(enum hapi_sim_call call, uint32_t n)
+{
+    if (call < HAPI_SIM_CALLS) {
+        hapi_sim_advance(sim.cost[call] * n);
+    }
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_key_edge()
+ *
+ *************************************************************************************************/
+void
+hapi_sim_key_edge(void)
+{
+    if (sim.key_evt) {
+        task_evt_set(sim.key_evt, TASK_EVT_KEY);
+    }
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_spi()
+ *
+ *************************************************************************************************/
+const struct hapi_sim_spi *
+hapi_sim_spi(void)
+{
+    return &sim.spi;
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_can_setup()
+ *
+ *************************************************************************************************/
+void
+hapi_sim_can_setup(uint16_t obj, uint32_t id, uint32_t mask)
+{
+    struct hapi_sim_can_obj *o = hapi_sim_can_obj(obj);
+
+    memset(o, 0u, sizeof(*o));
+    o->valid = true;
+    o->rx = true;
+    o->eob = true;
+    o->id = id & mask;
+    o->mask = mask;
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_can_receive()
+ *
+ *************************************************************************************************/
+uint16_t
+hapi_sim_can_receive(const struct can_f *f)
+{
+    uint16_t i;
+    for (i = 0U; i < HAPI_CAN_OBJECTS; i++) {
+        struct hapi_sim_can_obj *obj = &sim.obj[i];
+
+        if (!obj->valid || !obj->rx || ((f->id ^ obj->id) & obj->mask) != 0UL) {
+            continue;
+        }
+
+        /* Full object inside a FIFO, the frame goes to the next one */
+        if (obj->newdat && !obj->eob) {
+            continue;
+        }
+
+        obj->msglst = obj->newdat;
+        obj->newdat = true;
+        obj->f = *f;
+
+        if (obj->ie && sim.can_rx && !sim.can_locked) {
+            hapi_sim_can_isr();
+        }
+
+        return i + 1U;
+    }
+
+    return 0U;
+}
+
+/**************************************************************************************************
+ *
+ * hapi_sim_can_obj()
+ *
+ *************************************************************************************************/
+struct hapi_sim_can_obj *
+hapi_sim_can_obj(uint16_t obj)
+{
+    return &sim.obj[(obj - 1U) % HAPI_CAN_OBJECTS];
+}
+
+/**************************************************************************************************
+ *
+ * Hardware application interface
+ *
+ *************************************************************************************************/
+
+uint32_t
+hapi_timestamp(void)
+{
+    return sim.now;
+}
+
+uint32_t
+hapi_can_objects(void)
+{
+    uint32_t valid = 0UL;
+
+    uint16_t i;
+    for (i = 0U; i < HAPI_CAN_OBJECTS; i++) {
+        if (sim.obj[i].valid) {
+            valid |= 1UL << i;
+        }
+    }
+
+    return valid;
+}
+
+int
+hapi_can_filter(uint16_t obj, uint32_t id, uint32_t mask, bool last)
+{
+    if (obj < 1U || obj > HAPI_CAN_OBJECTS) {
+        return -1;
+    }
+
+    hapi_sim_can_setup(obj, id, mask);
+
+    struct hapi_sim_can_obj *o = hapi_sim_can_obj(obj);
+    o->ie = true;
+    o->eob = last;
+
+    return 0;
+}
+
+int
+hapi_can_accept_get(uint16_t obj, uint32_t *id, uint32_t *mask)
+{
+    if (obj < 1U || obj > HAPI_CAN_OBJECTS || !id || !mask) {
+        return -1;
+    }
+
+    const struct hapi_sim_can_obj *o = hapi_sim_can_obj(obj);
+    if (!o->valid || !o->rx) {
+        return -1;
+    }
+
+    *id = o->id;
+    *mask = o->mask;
+
+    return 0;
+}
+
+int
+hapi_can_accept_set(uint16_t obj, uint32_t id, uint32_t mask)
+{
+    if (obj < 1U || obj > HAPI_CAN_OBJECTS) {
+        return -1;
+    }
+
+    struct hapi_sim_can_obj *o = hapi_sim_can_obj(obj);
+    if (!o->valid || !o->rx) {
+        return -1;
+    }
+
+    /* A frame the object holds is kept */
+    o->id = id & mask;
+    o->mask = mask;
+
+    return 0;
+}
+
+int
+hapi_can_rx_enable(struct can_rx *can_rx)
+{
+    if (!can_rx) {
+        return -1;
+    }
+
+    sim.can_rx = can_rx;
+
+    /* Frames that arrived before the interrupt was enabled are pending */
+    hapi_sim_can_isr();
+
+    return 0;
+}
+
+void
+hapi_can_lock(bool lock)
+{
+    sim.can_locked = lock;
+
+    /* Interrupt pending while it was held off */
+    if (!lock && sim.can_rx) {
+        hapi_sim_can_isr();
+    }
+}
+
+int
+hapi_key_irq_enable(struct task_evt *evt)
+{
+    if (!evt) {
+        return -1;
+    }
+
+    sim.key_evt = evt;
+
+    return 0;
+}
+
+int
+hapi_adc_dma_enable(struct acq *acq)
+{
+    /* Blocks are not moved by DMA on the host, the PHY job runs at its fallback period */
+    return -1;
+}
+
+int
+hapi_screen_write(const uint8_t *data, uint16_t length, bool command)
+{
+    if (!data) {
+        return -1;
+    }
+
+    /* A DMA transfer in progress is not waited for */
+    if (sim.spi_active) {
+        sim.spi.rejected++;
+        return -1;
+    }
+
+    if (command) {
+        sim.spi.cmd_bytes += length;
+    } else {
+        sim.spi.data_bytes += length;
+    }
+    ssd1322_sim_write(data, length, command);
+    hapi_sim_charge(HAPI_SIM_SCREEN_BYTE, length);
+    sim.spi.last = sim.now;
+
+    return 0;
+}
+
+int
+hapi_screen_send(const uint8_t *data, uint16_t length, void (*done)(void *ctx), void *ctx)
+{
+    if (!data || length > HAPI_SCREEN_SEND_MAX || sim.spi_active) {
+        sim.spi.rejected++;
+        return -1;
+    }
+
+    sim.spi.dma_bytes += length;
+    sim.spi.transfers++;
+
+    sim.spi_done = done;
+    sim.spi_ctx = ctx;
+    sim.spi_data = data;
+    sim.spi_length = length;
+    sim.spi_end = sim.now + sim.cost[HAPI_SIM_SPI_BYTE] * length;
+    sim.spi_active = true;
+
+    /* A transfer that takes no time completes right away, from the interrupt */
+    hapi_sim_advance(0UL);
+
+    return 0;
+}
+
+void
+hapi_toggle_led_1(void)
+{
+}
@@ -0,0 +1,183 @@
+/**************************************************************************************************
+ *
+ * \file hapi_sim.h
+ *
+ * \brief Simulated hardware application interface for host builds. Implements the hapi_*()
+ * functions of app/hapi.h on top of a virtual clock, a model of the CAN controller message
+ * objects and an SPI sink in place of the display (decoded by ssd1322_sim.h), so application
+ * modules run unchanged on a workstation. Calls into the hardware and fw_lib take the virtual
+ * time set with hapi_sim_cost().
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_SIM_HAPI_SIM_H
+#define _HOST_SIM_HAPI_SIM_H
+
+#include "app/hapi.h"
+
+#include "inc/net/can.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Simulated CAN controller message object
+ *
+ *************************************************************************************************/
+struct hapi_sim_can_obj {
+    bool valid;                     /* MsgVal                                                   */
+    bool rx;                        /* Receive object                                           */
+    bool ie;                        /* Receive interrupt enabled                                */
+    bool eob;                       /* End of FIFO block (single objects have it set)           */
+    bool newdat;                    /* Holds a frame not read yet                               */
+    bool msglst;                    /* A frame was overwritten before it was read               */
+    uint32_t id;
+    uint32_t mask;
+    struct can_f f;
+};
+
+/**************************************************************************************************
+ *
+ * Calls that take virtual time, see hapi_sim_cost()
+ *
+ *************************************************************************************************/
+enum hapi_sim_call {
+    HAPI_SIM_SCREEN_BYTE,           /* Byte written to the display by the CPU                   */
+    HAPI_SIM_SPI_BYTE,              /* Byte shifted out by DMA, the CPU is free meanwhile       */
+    HAPI_SIM_CAN_READ,              /* Frame read from a message object                         */
+    HAPI_SIM_CAN_WRITE,             /* Frame written to a message object                        */
+    HAPI_SIM_DB_RUN,                /* One database processed by db_run()                       */
+    HAPI_SIM_KEY_READ,              /* Keys sampled by the key reader                           */
+    HAPI_SIM_RENDER,                /* Page drawn by the display library                        */
+    HAPI_SIM_CALLS
+};
+
+/**************************************************************************************************
+ *
+ * Display SPI sink counters
+ *
+ *************************************************************************************************/
+struct hapi_sim_spi {
+    uint32_t cmd_bytes;             /* Command bytes written                                    */
+    uint32_t data_bytes;            /* Data bytes written by the CPU                            */
+    uint32_t dma_bytes;             /* Data bytes sent by DMA                                   */
+    uint32_t transfers;             /* DMA transfers started                                    */
+    uint32_t rejected;              /* Writes and transfers refused while a DMA transfer ran    */
+    uint32_t last;                  /* End of the last byte sent (hapi_timestamp() ticks)       */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Resets the simulated hardware: clock at 0, every message object invalid, interrupts
+ * disabled, no SPI transfer in progress, display RAM cleared and every call free
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+hapi_sim_reset(void);
+
+/**************************************************************************************************
+ *
+ * \brief Advances the virtual clock read by hapi_timestamp(). A DMA transfer to the display that
+ * completes meanwhile calls its completion callback at its end time, as the interrupt would.
+ *
+ * \param ticks clock ticks (HAPI_TIMESTAMP_FREQ)
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+hapi_sim_advance(uint32_t ticks);
+
+/**************************************************************************************************
+ *
+ * \brief Sets the virtual time a call takes
+ *
+ * \param call simulated call
+ * \param ticks clock ticks (HAPI_TIMESTAMP_FREQ) per call, or per byte for the byte costs
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+hapi_sim_cost(enum hapi_sim_call call, uint32_t ticks);
+
+/**************************************************************************************************
+ *
+ * \brief Advances the virtual clock by the time n calls take
+ *
+ * \param call simulated call
+ * \param n number of calls or bytes
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+hapi_sim_charge(enum hapi_sim_call call, uint32_t n);
+
+/**************************************************************************************************
+ *
+ * \brief Raises a key edge, as the external interrupt of an encoder or button pin does
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+hapi_sim_key_edge(void);
+
+/**************************************************************************************************
+ *
+ * \brief Gives access to the display SPI sink counters
+ *
+ * \return SPI sink counters
+ *
+ *************************************************************************************************/
+extern const struct hapi_sim_spi *
+hapi_sim_spi(void);
+
+/**************************************************************************************************
+ *
+ * \brief Sets up a receive message object the way fw_lib's init() does: no receive interrupt,
+ * polled by the library
+ *
+ * \param obj message object, from 1 to HAPI_CAN_OBJECTS
+ * \param id CAN identifier
+ * \param mask CAN identifier mask
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+hapi_sim_can_setup(uint16_t obj, uint32_t id, uint32_t mask);
+
+/**************************************************************************************************
+ *
+ * \brief Puts a frame on the bus. The controller stores it in the lowest-numbered valid receive
+ * object that accepts it; a FIFO object that is full passes it on to the next one of the FIFO.
+ * Application objects are then read by the receive interrupt model, as on the target.
+ *
+ * \param f CAN frame
+ *
+ * \return Message object that stored the frame; 0 if no object accepted it
+ *
+ *************************************************************************************************/
+extern uint16_t
+hapi_sim_can_receive(const struct can_f *f);
+
+/**************************************************************************************************
+ *
+ * \brief Gives access to a simulated message object
+ *
+ * \param obj message object, from 1 to HAPI_CAN_OBJECTS
+ *
+ * \return Message object
+ *
+ *************************************************************************************************/
+extern struct hapi_sim_can_obj *
+hapi_sim_can_obj(uint16_t obj);
+
+#endif /* _HOST_SIM_HAPI_SIM_H */
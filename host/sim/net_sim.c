@@ -0,0 +1,86 @@
+/**************************************************************************************************
+ *
+ * \file net_sim.c
+ *
+ * \brief Simulated fw_lib CAN network implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "net_sim.h"
+#include "hapi_sim.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/** Frames waiting in fw_lib's receive objects                                                   */
+#define NET_SIM_RX_SIZE     (32U)
+
+static struct {
+    uint32_t tx_count;
+    struct can_f tx_last;
+    struct can_f rx[NET_SIM_RX_SIZE];
+    uint16_t rx_head;
+    uint16_t rx_count;
+} sim;
+
+int
+net_sim_rx(const struct can_f *f)
+{
+    if (!f || sim.rx_count >= NET_SIM_RX_SIZE) {
+        return -1;
+    }
+
+    sim.rx[(sim.rx_head + sim.rx_count) % NET_SIM_RX_SIZE] = *f;
+    sim.rx_count++;
+
+    return 0;
+}
+
+void
+net_sim_reset(void)
+{
+    memset(&sim, 0u, sizeof(sim));
+}
+
+uint32_t
+net_sim_tx_count(void)
+{
+    return sim.tx_count;
+}
+
+const struct can_f *
+net_sim_tx_last(void)
+{
+    return &sim.tx_last;
+}
+
+int
+can_write(const struct net *net, const struct can_f *f)
+{
+    if (!f) {
+        return -1;
+    }
+
+    sim.tx_count++;
+    sim.tx_last = *f;
+    hapi_sim_charge(HAPI_SIM_CAN_WRITE, 1U);
+
+    return 0;
+}
+
+int
+can_read(const struct net *net, struct can_f *f)
+{
+    if (!f || sim.rx_count == 0U) {
+        return 0;
+    }
+
+    *f = sim.rx[sim.rx_head];
+    sim.rx_head = (sim.rx_head + 1U) % NET_SIM_RX_SIZE;
+    sim.rx_count--;
+    hapi_sim_charge(HAPI_SIM_CAN_READ, 1U);
+
+    return 1;
+}
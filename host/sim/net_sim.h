@@ -0,0 +1,61 @@
+/**************************************************************************************************
+ *
+ * \file net_sim.h
+ *
+ * \brief Simulated fw_lib CAN network for host builds. Transmitted frames are counted and the
+ * last one is kept; frames queued with net_sim_rx() are what fw_lib's receive objects read.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_SIM_NET_SIM_H
+#define _HOST_SIM_NET_SIM_H
+
+#include "inc/net/can.h"
+
+#include <stdint.h>
+
+/**************************************************************************************************
+ *
+ * \brief Number of frames written since start-up
+ *
+ * \return Frame count
+ *
+ *************************************************************************************************/
+extern uint32_t
+net_sim_tx_count(void);
+
+/**************************************************************************************************
+ *
+ * \brief Last frame written
+ *
+ * \return CAN frame; all zero if nothing was written
+ *
+ *************************************************************************************************/
+extern const struct can_f *
+net_sim_tx_last(void);
+
+/**************************************************************************************************
+ *
+ * \brief Queues a frame for fw_lib's receive objects, read by the next db_run()
+ *
+ * \param f CAN frame
+ *
+ * \return 0 if frame is queued; -1 if the queue is full
+ *
+ *************************************************************************************************/
+extern int
+net_sim_rx(const struct can_f *f);
+
+/**************************************************************************************************
+ *
+ * \brief Drops every queued frame and clears the counters
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+net_sim_reset(void);
+
+#endif /* _HOST_SIM_NET_SIM_H */
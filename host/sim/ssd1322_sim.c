@@ -0,0 +1,198 @@
+/**************************************************************************************************
+ *
+ * \file ssd1322_sim.c
+ *
+ * \brief Simulated SSD1322 display controller implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "ssd1322_sim.h"
+
+#include "app/screen.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/** SSD1322 commands, and the panel in the display RAM (app/screen.c)                            */
+#define SSD1322_SIM_CMD_COLUMN  (0x15U)
+#define SSD1322_SIM_CMD_ROW     (0x75U)
+#define SSD1322_SIM_CMD_WRITE   (0x5CU)
+#define SSD1322_SIM_COL_START   (0x1CU)
+
+/**************************************************************************************************
+ *
+ * \brief Arguments taken by a command, so that they are not mistaken for pixels
+ *
+ *************************************************************************************************/
+static uint16_t
+ssd1322_sim_args(uint8_t cmd)
+{
+    switch (cmd) {
+    case 0x15U: case 0x75U: case 0xA0U: case 0xB4U: case 0xD1U:
+        return 2U;
+    case 0xA1U: case 0xA2U: case 0xABU: case 0xB1U: case 0xB3U: case 0xB5U: case 0xB6U:
+    case 0xBBU: case 0xBEU: case 0xC1U: case 0xC7U: case 0xCAU: case 0xFDU:
+        return 1U;
+    case 0xB8U:
+        return 15U;
+    default:
+        return 0U;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * Simulated controller state
+ *
+ *************************************************************************************************/
+static struct {
+    uint8_t ram[SSD1322_SIM_ROWS][SSD1322_SIM_COLS * 2U];
+    int16_t cmd;                    /* Command waiting for arguments, -1 if none                */
+    uint8_t arg[15];
+    uint16_t n_args;
+    bool writing;                   /* Data bytes go to the display RAM                         */
+    uint16_t col_lo, col_hi;        /* Window                                                   */
+    uint16_t row_lo, row_hi;
+    uint16_t x, y, half;            /* Write address                                            */
+} ssd;
+
+/**************************************************************************************************
+ *
+ * \brief Decodes one command byte
+ *
+ *************************************************************************************************/
+static void
+ssd1322_sim_command(uint8_t byte)
+{
+    ssd.writing = false;
+    ssd.n_args = 0U;
+    ssd.cmd = (ssd1322_sim_args(byte) > 0U) ? (int16_t) byte : -1;
+
+    if (byte == SSD1322_SIM_CMD_WRITE) {
+        ssd.writing = true;
+        ssd.x = ssd.col_lo;
+        ssd.y = ssd.row_lo;
+        ssd.half = 0U;
+    }
+}
+
+/**************************************************************************************************
+ *
+ * \brief Decodes one data byte: a command argument or two pixels
+ *
+ *************************************************************************************************/
+static void
+ssd1322_sim_data(uint8_t byte)
+{
+    if (ssd.cmd >= 0) {
+        ssd.arg[ssd.n_args++] = byte;
+        if (ssd.n_args == ssd1322_sim_args((uint8_t) ssd.cmd)) {
+            if (ssd.cmd == SSD1322_SIM_CMD_COLUMN) {
+                ssd.col_lo = ssd.arg[0] % SSD1322_SIM_COLS;
+                ssd.col_hi = ssd.arg[1] % SSD1322_SIM_COLS;
+            } else if (ssd.cmd == SSD1322_SIM_CMD_ROW) {
+                ssd.row_lo = ssd.arg[0] % SSD1322_SIM_ROWS;
+                ssd.row_hi = ssd.arg[1] % SSD1322_SIM_ROWS;
+            }
+            ssd.cmd = -1;
+        }
+        return;
+    }
+
+    if (!ssd.writing) {
+        return;
+    }
+
+    /* One column is two bytes (4 pixels), the address moves right, then down, then wraps */
+    ssd.ram[ssd.y][ssd.x * 2U + ssd.half] = byte;
+    ssd.half ^= 1U;
+    if (ssd.half == 0U && ++ssd.x > ssd.col_hi) {
+        ssd.x = ssd.col_lo;
+        if (++ssd.y > ssd.row_hi) {
+            ssd.y = ssd.row_lo;
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * ssd1322_sim_reset()
+ *
+ *************************************************************************************************/
+void
+ssd1322_sim_reset(void)
+{
+    memset(&ssd, 0u, sizeof(ssd));
+
+    ssd.cmd = -1;
+    ssd.col_hi = SSD1322_SIM_COLS - 1U;
+    ssd.row_hi = SSD1322_SIM_ROWS - 1U;
+}
+
+/**************************************************************************************************
+ *
+ * ssd1322_sim_write()
+ *
+ *************************************************************************************************/
+void
+ssd1322_sim_write(const uint8_t *data, uint16_t length, bool command)
+{
+    uint16_t i;
+    for (i = 0U; i < length; i++) {
+        if (command) {
+            ssd1322_sim_command(data[i]);
+        } else {
+            ssd1322_sim_data(data[i]);
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * ssd1322_sim_panel()
+ *
+ *************************************************************************************************/
+void
+ssd1322_sim_panel(uint8_t *buf)
+{
+    uint16_t row;
+    for (row = 0U; row < SCREEN_HEIGHT; row++) {
+        memcpy(&buf[row * SCREEN_ROW_BYTES], &ssd.ram[row][SSD1322_SIM_COL_START * 2U],
+            SCREEN_ROW_BYTES);
+    }
+}
+
+/**************************************************************************************************
+ *
+ * ssd1322_sim_pgm()
+ *
+ *************************************************************************************************/
+int
+ssd1322_sim_pgm(const char *path)
+{
+    static uint8_t buf[SCREEN_BUF_SIZE];
+    uint8_t line[SCREEN_WIDTH];
+
+    FILE *out = fopen(path, "wb");
+    if (!out) {
+        return -1;
+    }
+
+    ssd1322_sim_panel(buf);
+    fprintf(out, "P5\n%u %u\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+
+    uint16_t row;
+    for (row = 0U; row < SCREEN_HEIGHT; row++) {
+        uint16_t i;
+        for (i = 0U; i < SCREEN_ROW_BYTES; i++) {
+            uint8_t v = buf[row * SCREEN_ROW_BYTES + i];
+            line[2U * i] = (uint8_t) ((v >> 4) * 17U);
+            line[2U * i + 1U] = (uint8_t) ((v & 0x0FU) * 17U);
+        }
+        (void) fwrite(line, 1U, sizeof(line), out);
+    }
+
+    return (fclose(out) == 0) ? 0 : -1;
+}
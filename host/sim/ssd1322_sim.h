@@ -0,0 +1,72 @@
+/**************************************************************************************************
+ *
+ * \file ssd1322_sim.h
+ *
+ * \brief Simulated SSD1322 display controller for host builds. Bytes that reach the display
+ * through hapi_screen_write() and hapi_screen_send() are decoded into the controller display RAM,
+ * so the panel can be read back or saved as a PGM snapshot. Only the RAM write path is emulated,
+ * set-up commands are skipped.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_SIM_SSD1322_SIM_H
+#define _HOST_SIM_SSD1322_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Display RAM: 120 columns of 4 pixels, 128 rows                                               */
+#define SSD1322_SIM_COLS        (120U)
+#define SSD1322_SIM_ROWS        (128U)
+
+/**************************************************************************************************
+ *
+ * \brief Resets the controller: display RAM cleared, full window, no command pending
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+ssd1322_sim_reset(void);
+
+/**************************************************************************************************
+ *
+ * \brief Feeds bytes sent to the controller
+ *
+ * \param data bytes
+ * \param length number of bytes
+ * \param command true if sent with D/C low (command); false for data
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+ssd1322_sim_write(const uint8_t *data, uint16_t length, bool command);
+
+/**************************************************************************************************
+ *
+ * \brief Copies the panel out of the display RAM, in the frame format of app/screen.h
+ *
+ * \param buf frame buffer, SCREEN_BUF_SIZE bytes
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+ssd1322_sim_panel(uint8_t *buf);
+
+/**************************************************************************************************
+ *
+ * \brief Writes the panel as an 8-bit PGM image
+ *
+ * \param path file path
+ *
+ * \return 0 if operation is successful; -1 otherwise
+ *
+ *************************************************************************************************/
+extern int
+ssd1322_sim_pgm(const char *path);
+
+#endif /* _HOST_SIM_SSD1322_SIM_H */
@@ -0,0 +1,213 @@
+/**************************************************************************************************
+ *
+ * \file task_sim.c
+ *
+ * \brief Scheduler model implementation
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "task_sim.h"
+#include "hapi_sim.h"
+
+#include "app/tlo.h"
+#include "app/task.h"
+#include "app/task_prof.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TASK_SIM_TICKS_US   ((double) HAPI_TIMESTAMP_FREQ / 1e6)
+
+static struct {
+    const struct task *task;
+    struct task_sim_job job[TASK_JOBS_MAX];
+    uint16_t n;
+    uint32_t start;                 /* task_init() time                                         */
+} sim;
+
+/**************************************************************************************************
+ *
+ * task_init()
+ *
+ *************************************************************************************************/
+int
+task_init(const struct task *task)
+{
+    if (!task || !task->priv) {
+        return -1;
+    }
+
+    memset(&sim, 0u, sizeof(sim));
+    sim.task = task;
+    sim.start = hapi_timestamp();
+
+    uint16_t i;
+    for (i = 0U; i < TASK_JOBS_MAX && task->job[i]; i++) {
+        struct task_sim_job *job = &sim.job[i];
+
+        if (task->job[i]->freq <= 0.0f || !task->job[i]->callback) {
+            return -1;
+        }
+
+        job->job = task->job[i];
+        job->period = (uint32_t) ((float) HAPI_TIMESTAMP_FREQ / task->job[i]->freq);
+        job->next = sim.start;
+    }
+    sim.n = i;
+
+    return 0;
+}
+
+/**************************************************************************************************
+ *
+ * task_sim_run()
+ *
+ *************************************************************************************************/
+void
+task_sim_run(uint32_t ticks)
+{
+    if (!sim.task) {
+        return;
+    }
+
+    const struct tlo *tlo = sim.task->priv->tlo;
+    uint32_t end = hapi_timestamp() + ticks;
+
+    for (;;) {
+        uint32_t now = hapi_timestamp();
+        if ((int32_t) (now - end) >= 0) {
+            break;
+        }
+
+        /* Releases due by now, one pending run per job */
+        uint32_t wake = end;
+        uint16_t i;
+        for (i = 0U; i < sim.n; i++) {
+            struct task_sim_job *job = &sim.job[i];
+
+            while ((int32_t) (now - job->next) >= 0) {
+                if (job->pending) {
+                    job->dropped++;
+                } else {
+                    job->pending = true;
+                    job->release = job->next;
+                }
+                job->next += job->period;
+            }
+
+            if ((int32_t) (job->next - wake) < 0) {
+                wake = job->next;
+            }
+        }
+
+        /* First pending job in declaration order runs to completion */
+        struct task_sim_job *job = NULL;
+        for (i = 0U; i < sim.n && !job; i++) {
+            if (sim.job[i].pending) {
+                job = &sim.job[i];
+            }
+        }
+
+        if (!job) {
+            hapi_sim_advance(wake - now);
+            continue;
+        }
+
+        job->pending = false;
+        job->runs++;
+
+        uint32_t jitter = now - job->release;
+        job->jitter_sum += jitter;
+        if (jitter > job->jitter_max) {
+            job->jitter_max = jitter;
+        }
+
+        job->job->callback(tlo);
+
+        uint32_t done = hapi_timestamp();
+        job->busy += done - now;
+        if ((done - job->release) > job->period) {
+            job->late++;
+        }
+    }
+}
+
+/**************************************************************************************************
+ *
+ * task_sim_job()
+ *
+ *************************************************************************************************/
+const struct task_sim_job *
+task_sim_job(const char *name)
+{
+    uint16_t i;
+    for (i = 0U; i < sim.n; i++) {
+        if (name && strcmp(sim.job[i].job->name, name) == 0) {
+            return &sim.job[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**************************************************************************************************
+ *
+ * task_sim_report()
+ *
+ *************************************************************************************************/
+void
+task_sim_report(void)
+{
+    if (!sim.task) {
+        return;
+    }
+
+    double elapsed = (double) (hapi_timestamp() - sim.start);
+    double busy = 0.0;
+
+    printf("%-8s %10s %8s %12s %12s %6s %8s %7s\n",
+            "job", "period us", "runs", "jitter max", "jitter mean", "late", "dropped", "cpu %");
+
+    uint16_t i;
+    for (i = 0U; i < sim.n; i++) {
+        const struct task_sim_job *job = &sim.job[i];
+
+        printf("%-8s %10.1f %8u %12.2f %12.2f %6u %8u %7.2f\n",
+                job->job->name,
+                job->period / TASK_SIM_TICKS_US,
+                (unsigned) job->runs,
+                job->jitter_max / TASK_SIM_TICKS_US,
+                job->runs ? (double) job->jitter_sum / job->runs / TASK_SIM_TICKS_US : 0.0,
+                (unsigned) job->late,
+                (unsigned) job->dropped,
+                100.0 * (double) job->busy / elapsed);
+
+        busy += (double) job->busy;
+    }
+    printf("%-8s %77.2f\n", "total", 100.0 * busy / elapsed);
+
+    /* Jobs dispatched inside the slot task, as the profiler saw them over its last window */
+    const struct tlo *tlo = sim.task->priv->tlo;
+    if (!tlo || !tlo->task_prof) {
+        return;
+    }
+
+    printf("\n%-8s %8s %10s %10s %9s %7s\n", "profiled", "runs/s", "mean us", "max us",
+            "overruns", "cpu %");
+
+    for (i = 0U; i < TASK_PROF_N; i++) {
+        struct task_prof_stat stat;
+        const char *name = task_prof_get(tlo->task_prof, (enum task_prof_job) i, &stat);
+        if (!name) {
+            continue;
+        }
+
+        printf("%-8s %8u %10u %10u %9u %7.2f\n", name, (unsigned) stat.runs,
+                (unsigned) stat.mean, (unsigned) stat.max, (unsigned) stat.overruns,
+                (double) stat.mean * stat.runs / 1e4);
+    }
+    printf("%-8s %57.1f\n", "load", task_prof_load(tlo->task_prof) / 10.0);
+}
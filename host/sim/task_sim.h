@@ -0,0 +1,76 @@
+/**************************************************************************************************
+ *
+ * \file task_sim.h
+ *
+ * \brief Scheduler model for host builds. Runs the jobs of the task object built by task_new()
+ * on the virtual clock of hapi_sim.h: every job is released at its frequency and the first
+ * released job in declaration order runs to completion, as fw_lib's task_run() does. Job run
+ * time is whatever the calls the job makes are set to take with hapi_sim_cost().
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_SIM_TASK_SIM_H
+#define _HOST_SIM_TASK_SIM_H
+
+#include "inc/api/task.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**************************************************************************************************
+ *
+ * Job statistics since task_init() (hapi_timestamp() ticks)
+ *
+ *************************************************************************************************/
+struct task_sim_job {
+    const struct task_job *job;
+    uint32_t period;
+    uint32_t next;                  /* Next release                                             */
+    uint32_t release;               /* Release of the pending run                               */
+    bool pending;                   /* Released and not started yet                             */
+    uint32_t runs;
+    uint32_t late;                  /* Runs that ended after the next release                   */
+    uint32_t dropped;               /* Releases lost while the previous one was still pending   */
+    uint32_t jitter_max;            /* Longest delay from release to start                      */
+    uint64_t jitter_sum;
+    uint64_t busy;                  /* Time spent running                                       */
+};
+
+/**************************************************************************************************
+ *
+ * \brief Runs the scheduler for a stretch of virtual time
+ *
+ * \param ticks clock ticks (HAPI_TIMESTAMP_FREQ)
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+task_sim_run(uint32_t ticks);
+
+/**************************************************************************************************
+ *
+ * \brief Reads job statistics
+ *
+ * \param name job name as given to TASK_JOB_NEW()
+ *
+ * \return Job statistics; NULL if there is no such job
+ *
+ *************************************************************************************************/
+extern const struct task_sim_job *
+task_sim_job(const char *name);
+
+/**************************************************************************************************
+ *
+ * \brief Prints start jitter, deadline misses and CPU share of every job, then the same for the
+ * jobs profiled by app/task_prof.c over its last window
+ *
+ * \return None
+ *
+ *************************************************************************************************/
+extern void
+task_sim_report(void);
+
+#endif /* _HOST_SIM_TASK_SIM_H */
@@ -0,0 +1,63 @@
+/**************************************************************************************************
+ *
+ * \file ui_sim.c
+ *
+ * \brief Simulated user interface: the key reader and the page renders of the state machine
+ * only take their virtual time, see hapi_sim_cost(). The device page is bound by the screen job
+ * through page_follow(), as on the target.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/display/key.h"
+#include "app/display/state_machine.h"
+#include "app/tlo.h"
+#include "app/page.h"
+
+#include "hapi_sim.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static const struct tlo *ui_sim_tlo;
+
+struct keys *
+key_new(const struct tlo *tlo)
+{
+    static struct keys keys;
+    memset(&keys, 0u, sizeof(keys));
+    return &keys;
+}
+
+void
+read_key_button(struct keys *keys)
+{
+    keys->samples++;
+    hapi_sim_charge(HAPI_SIM_KEY_READ, 1U);
+}
+
+void
+read_key_coding(struct keys *keys)
+{
+    hapi_sim_charge(HAPI_SIM_KEY_READ, 1U);
+}
+
+struct state_machine *
+state_machine_new(const struct tlo *tlo)
+{
+    static struct state_machine state_machine;
+    memset(&state_machine, 0u, sizeof(state_machine));
+    state_machine.currentState = state_sniffer_stack;
+    ui_sim_tlo = tlo;
+    return &state_machine;
+}
+
+void
+state_machine_run(struct state_machine *state_machine)
+{
+    /* The device page is drawn by the screen job, only library pages take the render time */
+    if (page_selected(ui_sim_tlo) < 0) {
+        hapi_sim_charge(HAPI_SIM_RENDER, 1U);
+    }
+}
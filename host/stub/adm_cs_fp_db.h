@@ -0,0 +1,24 @@
+/**************************************************************************************************
+ *
+ * \file adm_cs_fp_db.h
+ *
+ * \brief Host stand-in for the generated ADM_CS_FP database object
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_ADM_CS_FP_DB_H
+#define _HOST_ADM_CS_FP_DB_H
+
+#include "inc/api/db.h"
+
+struct adm_cs_fp_db {
+    struct db db;
+};
+
+extern const struct adm_cs_fp_db *
+adm_cs_fp_db_new(const struct tlo *tlo);
+
+extern void
+adm_cs_fp_db_init(const struct adm_cs_fp_db *db, const struct tlo *tlo);
+
+#endif /* _HOST_ADM_CS_FP_DB_H */
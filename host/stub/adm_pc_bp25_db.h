@@ -0,0 +1,24 @@
+/**************************************************************************************************
+ *
+ * \file adm_pc_bp25_db.h
+ *
+ * \brief Host stand-in for the generated ADM_PC_BP25 database object
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_ADM_PC_BP25_DB_H
+#define _HOST_ADM_PC_BP25_DB_H
+
+#include "inc/api/db.h"
+
+struct adm_pc_bp25_db {
+    struct db db;
+};
+
+extern const struct adm_pc_bp25_db *
+adm_pc_bp25_db_new(const struct tlo *tlo);
+
+extern void
+adm_pc_bp25_db_init(const struct adm_pc_bp25_db *db, const struct tlo *tlo);
+
+#endif /* _HOST_ADM_PC_BP25_DB_H */
@@ -0,0 +1,131 @@
+/**************************************************************************************************
+ *
+ * \file HostFont3x5.h
+ *
+ * \brief Host stand-in for the display fonts: 3x5 pixel glyphs in Adafruit GFX format, lower case
+ * drawn as upper case. Only read by tools/atlas_gen.py, never compiled.
+ *
+ *************************************************************************************************/
+
+const uint8_t HostFont3x5Bitmaps[] PROGMEM = {
+    0x49, 0x04, 0xB4, 0x00, 0xBE, 0xFA, 0x79, 0x3C, 0xA5, 0x4A, 0x55, 0x56,
+    0x48, 0x00, 0x29, 0x22, 0x89, 0x28, 0x15, 0x50, 0x0B, 0xA0, 0x00, 0x28,
+    0x03, 0x80, 0x00, 0x04, 0x25, 0x48, 0xF6, 0xDE, 0x59, 0x2E, 0xE7, 0xCE,
+    0xE5, 0x9E, 0xB7, 0x92, 0xF3, 0x9E, 0xF3, 0xDE, 0xE5, 0x24, 0xF7, 0xDE,
+    0xF7, 0x9E, 0x08, 0x20, 0x08, 0x28, 0x2A, 0x22, 0x1C, 0x70, 0x88, 0xA8,
+    0xE5, 0x84, 0xF7, 0xCE, 0x57, 0xDA, 0xD7, 0x5C, 0x72, 0x46, 0xD6, 0xDC,
+    0xF3, 0x4E, 0xF3, 0x48, 0x72, 0xD6, 0xB7, 0xDA, 0xE9, 0x2E, 0x24, 0xD4,
+    0xB7, 0x5A, 0x92, 0x4E, 0xBF, 0xDA, 0xD6, 0xDA, 0x56, 0xD4, 0xD7, 0x48,
+    0x56, 0xE6, 0xD7, 0x5A, 0x71, 0x1C, 0xE9, 0x24, 0xB6, 0xD6, 0xB6, 0xA4,
+    0xB7, 0xFA, 0xB5, 0x5A, 0xB5, 0x24, 0xE5, 0x4E, 0xD2, 0x4C, 0x91, 0x12,
+    0x64, 0x96, 0x54, 0x00, 0x00, 0x0E, 0x88, 0x00, 0x57, 0xDA, 0xD7, 0x5C,
+    0x72, 0x46, 0xD6, 0xDC, 0xF3, 0x4E, 0xF3, 0x48, 0x72, 0xD6, 0xB7, 0xDA,
+    0xE9, 0x2E, 0x24, 0xD4, 0xB7, 0x5A, 0x92, 0x4E, 0xBF, 0xDA, 0xD6, 0xDA,
+    0x56, 0xD4, 0xD7, 0x48, 0x56, 0xE6, 0xD7, 0x5A, 0x71, 0x1C, 0xE9, 0x24,
+    0xB6, 0xD6, 0xB6, 0xA4, 0xB7, 0xFA, 0xB5, 0x5A, 0xB5, 0x24, 0xE5, 0x4E,
+    0x6A, 0x26, 0x49, 0x24, 0xC8, 0xAC, 0x07, 0xC0,
+};
+
+const GFXglyph HostFont3x5Glyphs[] PROGMEM = {
+    {     0, 0, 0, 4, 0,  0 },   // 0x20
+    {     0, 3, 5, 4, 0, -5 },   // 0x21 '!'
+    {     2, 3, 5, 4, 0, -5 },   // 0x22 '"'
+    {     4, 3, 5, 4, 0, -5 },   // 0x23 '#'
+    {     6, 3, 5, 4, 0, -5 },   // 0x24 '$'
+    {     8, 3, 5, 4, 0, -5 },   // 0x25 '%'
+    {    10, 3, 5, 4, 0, -5 },   // 0x26 '&'
+    {    12, 3, 5, 4, 0, -5 },   // 0x27 '''
+    {    14, 3, 5, 4, 0, -5 },   // 0x28 '('
+    {    16, 3, 5, 4, 0, -5 },   // 0x29 ')'
+    {    18, 3, 5, 4, 0, -5 },   // 0x2A '*'
+    {    20, 3, 5, 4, 0, -5 },   // 0x2B '+'
+    {    22, 3, 5, 4, 0, -5 },   // 0x2C ','
+    {    24, 3, 5, 4, 0, -5 },   // 0x2D '-'
+    {    26, 3, 5, 4, 0, -5 },   // 0x2E '.'
+    {    28, 3, 5, 4, 0, -5 },   // 0x2F '/'
+    {    30, 3, 5, 4, 0, -5 },   // 0x30 '0'
+    {    32, 3, 5, 4, 0, -5 },   // 0x31 '1'
+    {    34, 3, 5, 4, 0, -5 },   // 0x32 '2'
+    {    36, 3, 5, 4, 0, -5 },   // 0x33 '3'
+    {    38, 3, 5, 4, 0, -5 },   // 0x34 '4'
+    {    40, 3, 5, 4, 0, -5 },   // 0x35 '5'
+    {    42, 3, 5, 4, 0, -5 },   // 0x36 '6'
+    {    44, 3, 5, 4, 0, -5 },   // 0x37 '7'
+    {    46, 3, 5, 4, 0, -5 },   // 0x38 '8'
+    {    48, 3, 5, 4, 0, -5 },   // 0x39 '9'
+    {    50, 3, 5, 4, 0, -5 },   // 0x3A ':'
+    {    52, 3, 5, 4, 0, -5 },   // 0x3B ';'
+    {    54, 3, 5, 4, 0, -5 },   // 0x3C '<'
+    {    56, 3, 5, 4, 0, -5 },   // 0x3D '='
+    {    58, 3, 5, 4, 0, -5 },   // 0x3E '>'
+    {    60, 3, 5, 4, 0, -5 },   // 0x3F '?'
+    {    62, 3, 5, 4, 0, -5 },   // 0x40 '@'
+    {    64, 3, 5, 4, 0, -5 },   // 0x41 'A'
+    {    66, 3, 5, 4, 0, -5 },   // 0x42 'B'
+    {    68, 3, 5, 4, 0, -5 },   // 0x43 'C'
+    {    70, 3, 5, 4, 0, -5 },   // 0x44 'D'
+    {    72, 3, 5, 4, 0, -5 },   // 0x45 'E'
+    {    74, 3, 5, 4, 0, -5 },   // 0x46 'F'
+    {    76, 3, 5, 4, 0, -5 },   // 0x47 'G'
+    {    78, 3, 5, 4, 0, -5 },   // 0x48 'H'
+    {    80, 3, 5, 4, 0, -5 },   // 0x49 'I'
+    {    82, 3, 5, 4, 0, -5 },   // 0x4A 'J'
+    {    84, 3, 5, 4, 0, -5 },   // 0x4B 'K'
+    {    86, 3, 5, 4, 0, -5 },   // 0x4C 'L'
+    {    88, 3, 5, 4, 0, -5 },   // 0x4D 'M'
+    {    90, 3, 5, 4, 0, -5 },   // 0x4E 'N'
+    {    92, 3, 5, 4, 0, -5 },   // 0x4F 'O'
+    {    94, 3, 5, 4, 0, -5 },   // 0x50 'P'
+    {    96, 3, 5, 4, 0, -5 },   // 0x51 'Q'
+    {    98, 3, 5, 4, 0, -5 },   // 0x52 'R'
+    {   100, 3, 5, 4, 0, -5 },   // 0x53 'S'
+    {   102, 3, 5, 4, 0, -5 },   // 0x54 'T'
+    {   104, 3, 5, 4, 0, -5 },   // 0x55 'U'
+    {   106, 3, 5, 4, 0, -5 },   // 0x56 'V'
+    {   108, 3, 5, 4, 0, -5 },   // 0x57 'W'
+    {   110, 3, 5, 4, 0, -5 },   // 0x58 'X'
+    {   112, 3, 5, 4, 0, -5 },   // 0x59 'Y'
+    {   114, 3, 5, 4, 0, -5 },   // 0x5A 'Z'
+    {   116, 3, 5, 4, 0, -5 },   // 0x5B '['
+    {   118, 3, 5, 4, 0, -5 },   // 0x5C
+    {   120, 3, 5, 4, 0, -5 },   // 0x5D ']'
+    {   122, 3, 5, 4, 0, -5 },   // 0x5E '^'
+    {   124, 3, 5, 4, 0, -5 },   // 0x5F '_'
+    {   126, 3, 5, 4, 0, -5 },   // 0x60 '`'
+    {   128, 3, 5, 4, 0, -5 },   // 0x61 'a'
+    {   130, 3, 5, 4, 0, -5 },   // 0x62 'b'
+    {   132, 3, 5, 4, 0, -5 },   // 0x63 'c'
+    {   134, 3, 5, 4, 0, -5 },   // 0x64 'd'
+    {   136, 3, 5, 4, 0, -5 },   // 0x65 'e'
+    {   138, 3, 5, 4, 0, -5 },   // 0x66 'f'
+    {   140, 3, 5, 4, 0, -5 },   // 0x67 'g'
+    {   142, 3, 5, 4, 0, -5 },   // 0x68 'h'
+    {   144, 3, 5, 4, 0, -5 },   // 0x69 'i'
+    {   146, 3, 5, 4, 0, -5 },   // 0x6A 'j'
+    {   148, 3, 5, 4, 0, -5 },   // 0x6B 'k'
+    {   150, 3, 5, 4, 0, -5 },   // 0x6C 'l'
+    {   152, 3, 5, 4, 0, -5 },   // 0x6D 'm'
+    {   154, 3, 5, 4, 0, -5 },   // 0x6E 'n'
+    {   156, 3, 5, 4, 0, -5 },   // 0x6F 'o'
+    {   158, 3, 5, 4, 0, -5 },   // 0x70 'p'
+    {   160, 3, 5, 4, 0, -5 },   // 0x71 'q'
+    {   162, 3, 5, 4, 0, -5 },   // 0x72 'r'
+    {   164, 3, 5, 4, 0, -5 },   // 0x73 's'
+    {   166, 3, 5, 4, 0, -5 },   // 0x74 't'
+    {   168, 3, 5, 4, 0, -5 },   // 0x75 'u'
+    {   170, 3, 5, 4, 0, -5 },   // 0x76 'v'
+    {   172, 3, 5, 4, 0, -5 },   // 0x77 'w'
+    {   174, 3, 5, 4, 0, -5 },   // 0x78 'x'
+    {   176, 3, 5, 4, 0, -5 },   // 0x79 'y'
+    {   178, 3, 5, 4, 0, -5 },   // 0x7A 'z'
+    {   180, 3, 5, 4, 0, -5 },   // 0x7B '{'
+    {   182, 3, 5, 4, 0, -5 },   // 0x7C '|'
+    {   184, 3, 5, 4, 0, -5 },   // 0x7D '}'
+    {   186, 3, 5, 4, 0, -5 },   // 0x7E '~'
+};
+
+const GFXfont HostFont3x5 PROGMEM = {
+    (uint8_t *)HostFont3x5Bitmaps,
+    (GFXglyph *)HostFont3x5Glyphs,
+    0x20, 0x7E, 7
+};
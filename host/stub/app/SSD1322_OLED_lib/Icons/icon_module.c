@@ -0,0 +1,19 @@
+/**************************************************************************************************
+ *
+ * \file icon_module.c
+ *
+ * \brief Host stand-in for the module icon, 8x8 pixels, 8 bits per pixel. Only read by
+ * tools/atlas_gen.py, never compiled.
+ *
+ *************************************************************************************************/
+
+const unsigned char icon_module[] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xFF, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0xFF,
+    0xFF, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0xFF,
+    0xFF, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00, 0xFF,
+    0xFF, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
@@ -0,0 +1,11 @@
+/**************************************************************************************************
+ *
+ * \file icons.c
+ *
+ * \brief Host stand-in for the display icon bitmaps
+ *
+ *************************************************************************************************/
+
+#include "app/SSD1322_OLED_lib/Icons/icons.h"
+
+const unsigned char icon_none[1];
@@ -0,0 +1,14 @@
+/**************************************************************************************************
+ *
+ * \file icons.h
+ *
+ * \brief Host stand-in for the display icon bitmaps
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_SSD1322_OLED_LIB_ICONS_ICONS_H
+#define _HOST_APP_SSD1322_OLED_LIB_ICONS_ICONS_H
+
+extern const unsigned char icon_none[];
+
+#endif /* _HOST_APP_SSD1322_OLED_LIB_ICONS_ICONS_H */
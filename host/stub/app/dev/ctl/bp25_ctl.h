@@ -0,0 +1,45 @@
+/**************************************************************************************************
+ *
+ * \file bp25_ctl.h
+ *
+ * \brief Host stand-in for the BP25 device driver
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_DEV_CTL_BP25_CTL_H
+#define _HOST_APP_DEV_CTL_BP25_CTL_H
+
+#include "app/dev/ctl/dev_stub.h"
+
+enum BP25_mode {
+    BP25_mode_none,
+    BP25_mode_on,
+    enum_BP25_mode_end
+};
+
+enum BP25_setpoints {
+    BP25_setpoint_voltage,
+    BP25_setpoint_current,
+    BP25_setpoint_power,
+    enum_BP25_setpoints_end
+};
+
+enum BP25_mesurables {
+    BP25_energized,
+    BP25_voltage,
+    BP25_current,
+    BP25_power,
+    BP25_temp_bridge,
+    enum_BP25_mesurables_end
+};
+
+enum BP25_fault {
+    BP25_fault_overvoltage,
+    BP25_fault_overcurrent,
+    BP25_fault_overtemperature,
+    enum_BP25_fault_end
+};
+
+DEV_STUB_DRIVER(BP25)
+
+#endif /* _HOST_APP_DEV_CTL_BP25_CTL_H */
@@ -0,0 +1,31 @@
+/**************************************************************************************************
+ *
+ * \file dev_stub.c
+ *
+ * \brief Host stand-in for the device drivers: every function returns a neutral default
+ *
+ *************************************************************************************************/
+
+#include "app/dev/ctl/bp25_ctl.h"
+#include "app/dev/ctl/vg11_fm01_ctl.h"
+#include "app/dev/ctl/vg11_fm02_ctl.h"
+
+#include <stddef.h>
+
+static const unsigned char dev_stub_icon[1];
+
+#define DEV_STUB_DRIVER_IMPL(DRV)                                                               \
+const char *DRV##_fault_to_str(enum DRV##_fault fault) { return "FAULT"; }                      \
+bool DRV##_mode_is_supported(enum DRV##_mode mode) { return mode < enum_##DRV##_mode_end; }     \
+const char *DRV##_mode_to_str(enum DRV##_mode mode) { return "MODE"; }                          \
+const unsigned char *DRV##_mode_to_icon(enum DRV##_mode mode) { return dev_stub_icon; }         \
+int DRV##_mesurables_view_param(enum DRV##_mesurables mesurable, int param) { return 0; }       \
+const char *DRV##_mesurables_to_str(enum DRV##_mesurables mesurable, int param) { return "M"; } \
+const char *DRV##_setpoints_to_str(enum DRV##_setpoints setpoint, int param) { return "S"; }    \
+double DRV##_setables_param(enum DRV##_setpoints setpoint, int param) { return 0.0; }           \
+void DRV##_setpoints_check(enum DRV##_setpoints setpoint, double *value) { }                    \
+int DRV##_mode_main_view(enum DRV##_mode mode, int param) { return 0; }
+
+DEV_STUB_DRIVER_IMPL(BP25)
+DEV_STUB_DRIVER_IMPL(VG11_FM01)
+DEV_STUB_DRIVER_IMPL(VG11_FM02)
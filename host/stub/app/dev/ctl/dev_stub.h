@@ -0,0 +1,27 @@
+/**************************************************************************************************
+ *
+ * \file dev_stub.h
+ *
+ * \brief Host stand-in for the device driver interface shared by the app/dev/ctl headers. Each
+ * driver has a few modes, setpoints, mesurables and faults; the functions only return defaults.
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_DEV_CTL_DEV_STUB_H
+#define _HOST_APP_DEV_CTL_DEV_STUB_H
+
+#include <stdbool.h>
+
+#define DEV_STUB_DRIVER(DRV)                                                                    \
+extern const char *DRV##_fault_to_str(enum DRV##_fault fault);                                  \
+extern bool DRV##_mode_is_supported(enum DRV##_mode mode);                                      \
+extern const char *DRV##_mode_to_str(enum DRV##_mode mode);                                     \
+extern const unsigned char *DRV##_mode_to_icon(enum DRV##_mode mode);                           \
+extern int DRV##_mesurables_view_param(enum DRV##_mesurables mesurable, int param);             \
+extern const char *DRV##_mesurables_to_str(enum DRV##_mesurables mesurable, int param);         \
+extern const char *DRV##_setpoints_to_str(enum DRV##_setpoints setpoint, int param);            \
+extern double DRV##_setables_param(enum DRV##_setpoints setpoint, int param);                   \
+extern void DRV##_setpoints_check(enum DRV##_setpoints setpoint, double *value);                \
+extern int DRV##_mode_main_view(enum DRV##_mode mode, int param);
+
+#endif /* _HOST_APP_DEV_CTL_DEV_STUB_H */
@@ -0,0 +1,45 @@
+/**************************************************************************************************
+ *
+ * \file vg11_fm01_ctl.h
+ *
+ * \brief Host stand-in for the VG11_FM01 device driver
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_DEV_CTL_VG11_FM01_CTL_H
+#define _HOST_APP_DEV_CTL_VG11_FM01_CTL_H
+
+#include "app/dev/ctl/dev_stub.h"
+
+enum VG11_FM01_mode {
+    VG11_FM01_mode_none,
+    VG11_FM01_mode_on,
+    enum_VG11_FM01_mode_end
+};
+
+enum VG11_FM01_setpoints {
+    VG11_FM01_setpoint_voltage,
+    VG11_FM01_setpoint_current,
+    VG11_FM01_setpoint_power,
+    enum_VG11_FM01_setpoints_end
+};
+
+enum VG11_FM01_mesurables {
+    VG11_FM01_energized,
+    VG11_FM01_voltage,
+    VG11_FM01_current,
+    VG11_FM01_power,
+    VG11_FM01_temp_bridge,
+    enum_VG11_FM01_mesurables_end
+};
+
+enum VG11_FM01_fault {
+    VG11_FM01_fault_overvoltage,
+    VG11_FM01_fault_overcurrent,
+    VG11_FM01_fault_overtemperature,
+    enum_VG11_FM01_fault_end
+};
+
+DEV_STUB_DRIVER(VG11_FM01)
+
+#endif /* _HOST_APP_DEV_CTL_VG11_FM01_CTL_H */
@@ -0,0 +1,46 @@
+/**************************************************************************************************
+ *
+ * \file vg11_fm02_ctl.h
+ *
+ * \brief Host stand-in for the VG11_FM02 device driver
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_DEV_CTL_VG11_FM02_CTL_H
+#define _HOST_APP_DEV_CTL_VG11_FM02_CTL_H
+
+#include "app/dev/ctl/dev_stub.h"
+
+enum VG11_FM02_mode {
+    VG11_FM02_mode_none,
+    VG11_FM02_mode_grid_following,
+    VG11_FM02_mode_pwm,
+    enum_VG11_FM02_mode_end
+};
+
+enum VG11_FM02_setpoints {
+    VG11_FM02_setpoint_voltage,
+    VG11_FM02_setpoint_current,
+    VG11_FM02_setpoint_power,
+    enum_VG11_FM02_setpoints_end
+};
+
+enum VG11_FM02_mesurables {
+    VG11_FM02_energized,
+    VG11_FM02_voltage,
+    VG11_FM02_current,
+    VG11_FM02_power,
+    VG11_FM02_temp_bridge,
+    enum_VG11_FM02_mesurables_end
+};
+
+enum VG11_FM02_fault {
+    VG11_FM02_fault_overvoltage,
+    VG11_FM02_fault_overcurrent,
+    VG11_FM02_fault_overtemperature,
+    enum_VG11_FM02_fault_end
+};
+
+DEV_STUB_DRIVER(VG11_FM02)
+
+#endif /* _HOST_APP_DEV_CTL_VG11_FM02_CTL_H */
@@ -0,0 +1,29 @@
+/**************************************************************************************************
+ *
+ * \file key.h
+ *
+ * \brief Host stand-in for the key reader. Keys are sampled by the model in sim/ui_sim.c.
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_DISPLAY_KEY_H
+#define _HOST_APP_DISPLAY_KEY_H
+
+#include <stdint.h>
+
+struct tlo;
+
+struct keys {
+    uint32_t samples;
+};
+
+extern struct keys *
+key_new(const struct tlo *tlo);
+
+extern void
+read_key_button(struct keys *keys);
+
+extern void
+read_key_coding(struct keys *keys);
+
+#endif /* _HOST_APP_DISPLAY_KEY_H */
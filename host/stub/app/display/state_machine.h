@@ -0,0 +1,35 @@
+/**************************************************************************************************
+ *
+ * \file state_machine.h
+ *
+ * \brief Host stand-in for the user interface state machine. Only the current state is modelled,
+ * the device registry looks at it to decide whether device type broadcasts are taken.
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_DISPLAY_STATE_MACHINE_H
+#define _HOST_APP_DISPLAY_STATE_MACHINE_H
+
+struct tlo;
+
+enum state_machine_state {
+    state_welcome,
+    state_sniffer_stack,
+    state_sniffer_version,
+    state_sniffer_interlock,
+    state_select_superset,
+    state_set_module,
+    state_main,
+};
+
+struct state_machine {
+    enum state_machine_state currentState;
+};
+
+extern struct state_machine *
+state_machine_new(const struct tlo *tlo);
+
+extern void
+state_machine_run(struct state_machine *state_machine);
+
+#endif /* _HOST_APP_DISPLAY_STATE_MACHINE_H */
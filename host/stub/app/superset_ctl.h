@@ -0,0 +1,21 @@
+/**************************************************************************************************
+ *
+ * \file superset_ctl.h
+ *
+ * \brief Host stand-in for the superset controller, created by tlo_new() and otherwise unused
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_APP_SUPERSET_CTL_H
+#define _HOST_APP_SUPERSET_CTL_H
+
+struct tlo;
+
+struct superset_ctl {
+    int unused;
+};
+
+extern const struct superset_ctl *
+superset_ctl_new(const struct tlo *tlo);
+
+#endif /* _HOST_APP_SUPERSET_CTL_H */
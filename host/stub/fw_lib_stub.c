@@ -0,0 +1,114 @@
+/**************************************************************************************************
+ *
+ * \file fw_lib_stub.c
+ *
+ * \brief Host stand-ins for the fw_lib start-up, alert and ADC functions and the generated
+ * databases tlo_new() creates
+ *
+ *************************************************************************************************/
+
+#include "inc/lib/nfo.h"
+#include "inc/lib/init.h"
+#include "inc/lib/alert.h"
+#include "inc/hal/hal.h"
+#include "inc/api/adc.h"
+
+#include "adm_cs_fp_db.h"
+#include "adm_pc_bp25_db.h"
+#include "adm_pc_vg11_fm01_db.h"
+#include "adm_pc_vg11_fm02_db.h"
+
+#include "app/superset_ctl.h"
+
+#include "hapi_sim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/** fw_lib's catch-all receive object, see test/can_filter_test.c                               */
+#define FW_LIB_STUB_CAN_OBJ (17U)
+
+static bool alert[ALERT_N];
+
+struct nfo *
+nfo_new(enum nfo_id id)
+{
+    static struct nfo nfo[2];
+    static unsigned n = 0U;
+
+    struct nfo *self = &nfo[n++ % 2U];
+    memset(self, 0u, sizeof(*self));
+    self->id = id;
+
+    return self;
+}
+
+void
+init(struct nfo *mod, struct nfo *boot, struct mal **mal, const struct net **can, uint32_t mask)
+{
+    *mal = NULL;
+    *can = NULL;
+
+    hapi_sim_can_setup(FW_LIB_STUB_CAN_OBJ, 0UL, mask);
+}
+
+void
+alert_set(enum alert id, bool state)
+{
+    alert[id] = state;
+}
+
+bool
+alert_get(enum alert id)
+{
+    return alert[id];
+}
+
+bool
+alert_get_group(enum alert_group group)
+{
+    return alert[ALERT_SYSTEM];
+}
+
+void
+alert_period(enum alert id, uint16_t period)
+{
+}
+
+void
+hal_reset(void)
+{
+    abort();
+}
+
+int
+adc_init(const struct adc *adc, const struct nfo *mod, struct mal *mal)
+{
+    return 0;
+}
+
+const struct superset_ctl *
+superset_ctl_new(const struct tlo *tlo)
+{
+    static struct superset_ctl superset_ctl;
+    return &superset_ctl;
+}
+
+#define DB_STUB_IMPL(NAME)                                                                      \
+const struct NAME##_db *                                                                        \
+NAME##_db_new(const struct tlo *tlo)                                                            \
+{                                                                                               \
+    static struct NAME##_db db;                                                                 \
+    memset(&db, 0u, sizeof(db));                                                                \
+    db.db.priv.tlo = tlo;                                                                       \
+    return &db;                                                                                 \
+}                                                                                               \
+void                                                                                            \
+NAME##_db_init(const struct NAME##_db *db, const struct tlo *tlo)                               \
+{                                                                                               \
+}
+
+DB_STUB_IMPL(adm_cs_fp)
+DB_STUB_IMPL(adm_pc_bp25)
+DB_STUB_IMPL(adm_pc_vg11_fm01)
+DB_STUB_IMPL(adm_pc_vg11_fm02)
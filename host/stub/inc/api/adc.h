@@ -0,0 +1,41 @@
+/**************************************************************************************************
+ *
+ * \file adc.h
+ *
+ * \brief Host stand-in for the fw_lib ADC interface. Variables are laid out as on the target and
+ * never converted.
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_API_ADC_H
+#define _HOST_INC_API_ADC_H
+
+#include "inc/lib/debug.h"
+
+struct nfo;
+struct mal;
+struct adc;
+
+struct adc_var {
+    const char *name;
+    float value;
+};
+
+#define ADC_OBJ_STRUCT(...)             struct adc { __VA_ARGS__ }
+#define ADC_OBJ_STRUCT_MEMBER(name)     struct adc_var *name
+
+#define ADC_VAR_NEW(name)               static struct adc_var name = { #name, 0.0f }
+#define ADC_OBJ_NEW(...)                static struct adc adc = { __VA_ARGS__ }
+
+#ifndef OBJ_MEMBER_SET
+#define OBJ_MEMBER_SET(name)            .name = &name
+#endif
+
+/** Implemented by the application                                                                */
+extern const struct adc *
+adc_new(const struct nfo *mod, struct mal *mal);
+
+extern int
+adc_init(const struct adc *adc, const struct nfo *mod, struct mal *mal);
+
+#endif /* _HOST_INC_API_ADC_H */
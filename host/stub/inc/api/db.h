@@ -0,0 +1,46 @@
+/**************************************************************************************************
+ *
+ * \file db.h
+ *
+ * \brief Host stand-in for the fw_lib CAN database interface, run by the model in sim/db_sim.c
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_API_DB_H
+#define _HOST_INC_API_DB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+struct tlo;
+struct net;
+struct can_f;
+
+#define DB_ID_DEV_ADR_M     (0x00FFU)
+
+struct db_priv {
+    const struct tlo *tlo;
+};
+
+/** Generated database objects start with this header                                           */
+struct db {
+    struct db_priv priv;
+    bool subscribed;
+    uint16_t id;
+    uint16_t address;
+};
+
+extern void
+db_run(const struct net *net, const struct db *db[], uint16_t n);
+
+extern void
+db_subscribe(const struct db *db, uint16_t id, uint16_t address, uint16_t mask);
+
+extern void
+db_unsubscribe(const struct db *db);
+
+extern void
+db_add_exception_filter(bool (*filter)(const struct db_priv *db_priv, const struct can_f *f),
+        const struct db *db);
+
+#endif /* _HOST_INC_API_DB_H */
@@ -0,0 +1,61 @@
+/**************************************************************************************************
+ *
+ * \file task.h
+ *
+ * \brief Host stand-in for the fw_lib task scheduler interface. Jobs are collected the way
+ * TASK_OBJ_NEW() lays them out and run by the scheduler model in sim/task_sim.c.
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_API_TASK_H
+#define _HOST_INC_API_TASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+struct tlo;
+struct task;
+
+/** Most jobs one task object can hold                                                           */
+#define TASK_JOBS_MAX   (8U)
+
+struct task_job {
+    const char *name;
+    float freq;
+    void (*callback)(const struct tlo *tlo);
+};
+
+struct task_priv {
+    const struct tlo *tlo;
+};
+
+#define TASK_OBJ_STRUCT(...)                                                                    \
+struct task {                                                                                   \
+    struct task_priv *priv;                                                                     \
+    union {                                                                                     \
+        struct { __VA_ARGS__ };                                                                 \
+        struct task_job *job[TASK_JOBS_MAX];                                                    \
+    };                                                                                          \
+}
+
+#define TASK_OBJ_STRUCT_MEMBER(name)    struct task_job *name
+
+#define TASK_JOB_NEW(name, freq, callback)                                                      \
+    static struct task_job name = { #name, (freq), (callback) }
+
+#define TASK_OBJ_NEW(...)                                                                       \
+    static struct task_priv priv;                                                               \
+    static struct task task = { .priv = &priv, { { __VA_ARGS__ } } }
+
+#ifndef OBJ_MEMBER_SET
+#define OBJ_MEMBER_SET(name)            .name = &name
+#endif
+
+/** Implemented by the application                                                                */
+extern const struct task *
+task_new(const struct tlo *tlo);
+
+extern int
+task_init(const struct task *task);
+
+#endif /* _HOST_INC_API_TASK_H */
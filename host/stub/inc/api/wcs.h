@@ -0,0 +1,18 @@
+/**************************************************************************************************
+ *
+ * \file wcs.h
+ *
+ * \brief Host stand-in for the fw_lib winding current sensing interface
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_API_WCS_H
+#define _HOST_INC_API_WCS_H
+
+struct nfo;
+struct adc;
+
+#define WCS_OBJ_STRUCT(...)             struct wcs { __VA_ARGS__ }
+#define WCS_OBJ_STRUCT_MEMBER(name)     float *name
+
+#endif /* _HOST_INC_API_WCS_H */
@@ -0,0 +1,17 @@
+/**************************************************************************************************
+ *
+ * \file adc.h
+ *
+ * \brief Host stand-in for the fw_lib ADC driver. Only what app/hapi.h needs to compile.
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_DRV_ADC_H
+#define _HOST_INC_DRV_ADC_H
+
+#include <stdint.h>
+
+#define _ADC_OBJ_STRUCT(...)            struct _adc { int unused; }
+#define _ADC_OBJ_STRUCT_MEMBER(name)
+
+#endif /* _HOST_INC_DRV_ADC_H */
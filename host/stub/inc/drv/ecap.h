@@ -0,0 +1,14 @@
+/**************************************************************************************************
+ *
+ * \file ecap.h
+ *
+ * \brief Host stand-in for the fw_lib eCAP driver
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_DRV_ECAP_H
+#define _HOST_INC_DRV_ECAP_H
+
+struct _ecap;
+
+#endif /* _HOST_INC_DRV_ECAP_H */
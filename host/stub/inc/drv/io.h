@@ -0,0 +1,16 @@
+/**************************************************************************************************
+ *
+ * \file io.h
+ *
+ * \brief Host stand-in for the fw_lib I/O driver
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_DRV_IO_H
+#define _HOST_INC_DRV_IO_H
+
+enum io {
+    IOX,
+};
+
+#endif /* _HOST_INC_DRV_IO_H */
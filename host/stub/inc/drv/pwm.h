@@ -0,0 +1,15 @@
+/**************************************************************************************************
+ *
+ * \file pwm.h
+ *
+ * \brief Host stand-in for the fw_lib PWM driver. Only what app/hapi.h needs to compile.
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_DRV_PWM_H
+#define _HOST_INC_DRV_PWM_H
+
+#define _PWM_OBJ_STRUCT(...)            struct _pwm { int unused; }
+#define _PWM_OBJ_STRUCT_MEMBER(name)
+
+#endif /* _HOST_INC_DRV_PWM_H */
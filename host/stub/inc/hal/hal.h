@@ -0,0 +1,15 @@
+/**************************************************************************************************
+ *
+ * \file hal.h
+ *
+ * \brief Host stand-in for the fw_lib hardware abstraction layer
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_HAL_HAL_H
+#define _HOST_INC_HAL_HAL_H
+
+extern void
+hal_reset(void);
+
+#endif /* _HOST_INC_HAL_HAL_H */
@@ -0,0 +1,18 @@
+/**************************************************************************************************
+ *
+ * \file hapi.h
+ *
+ * \brief Host stand-in for the fw_lib hardware abstraction hooks
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_HAL_HAPI_H
+#define _HOST_INC_HAL_HAPI_H
+
+struct hapi;
+
+struct _hapi {
+    struct hapi *hapi;
+};
+
+#endif /* _HOST_INC_HAL_HAPI_H */
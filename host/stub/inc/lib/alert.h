@@ -0,0 +1,37 @@
+/**************************************************************************************************
+ *
+ * \file alert.h
+ *
+ * \brief Host stand-in for the fw_lib alert interface
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_ALERT_H
+#define _HOST_INC_LIB_ALERT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum alert {
+    ALERT_SYSTEM,
+    ALERT_EXTERNAL,
+    ALERT_N
+};
+
+enum alert_group {
+    ALERT_ERROR,
+};
+
+extern void
+alert_set(enum alert alert, bool state);
+
+extern bool
+alert_get(enum alert alert);
+
+extern bool
+alert_get_group(enum alert_group group);
+
+extern void
+alert_period(enum alert alert, uint16_t period);
+
+#endif /* _HOST_INC_LIB_ALERT_H */
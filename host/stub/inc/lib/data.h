@@ -0,0 +1,12 @@
+/**************************************************************************************************
+ *
+ * \file data.h
+ *
+ * \brief Host stand-in for the fw_lib data helpers
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_DATA_H
+#define _HOST_INC_LIB_DATA_H
+
+#endif /* _HOST_INC_LIB_DATA_H */
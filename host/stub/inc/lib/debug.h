@@ -0,0 +1,16 @@
+/**************************************************************************************************
+ *
+ * \file debug.h
+ *
+ * \brief Host stand-in for the fw_lib debug helpers
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_DEBUG_H
+#define _HOST_INC_LIB_DEBUG_H
+
+#include <assert.h>
+
+#define ASSERT(x)   assert(x)
+
+#endif /* _HOST_INC_LIB_DEBUG_H */
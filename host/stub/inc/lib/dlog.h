@@ -0,0 +1,12 @@
+/**************************************************************************************************
+ *
+ * \file dlog.h
+ *
+ * \brief Host stand-in for the fw_lib data logger header, not used in host builds
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_DLOG_H
+#define _HOST_INC_LIB_DLOG_H
+
+#endif /* _HOST_INC_LIB_DLOG_H */
@@ -0,0 +1,12 @@
+/**************************************************************************************************
+ *
+ * \file iir.h
+ *
+ * \brief Host stand-in for the fw_lib IIR filter header, not used in host builds
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_IIR_H
+#define _HOST_INC_LIB_IIR_H
+
+#endif /* _HOST_INC_LIB_IIR_H */
@@ -0,0 +1,21 @@
+/**************************************************************************************************
+ *
+ * \file init.h
+ *
+ * \brief Host stand-in for the fw_lib start-up sequence
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_INIT_H
+#define _HOST_INC_LIB_INIT_H
+
+#include <stdint.h>
+
+struct nfo;
+struct mal;
+struct net;
+
+extern void
+init(struct nfo *mod, struct nfo *boot, struct mal **mal, const struct net **can, uint32_t mask);
+
+#endif /* _HOST_INC_LIB_INIT_H */
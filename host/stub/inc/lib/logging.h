@@ -0,0 +1,12 @@
+/**************************************************************************************************
+ *
+ * \file logging.h
+ *
+ * \brief Host stand-in for the fw_lib logging header, not used in host builds
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_LOGGING_H
+#define _HOST_INC_LIB_LOGGING_H
+
+#endif /* _HOST_INC_LIB_LOGGING_H */
@@ -0,0 +1,47 @@
+/**************************************************************************************************
+ *
+ * \file nfo.h
+ *
+ * \brief Host stand-in for the fw_lib module information interface
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_NFO_H
+#define _HOST_INC_LIB_NFO_H
+
+#include <stdint.h>
+
+enum nfo_id {
+    NFO_NONE = 0,
+    NFO_BOOT,
+    NFO_FP,
+    NFO_LF45,
+    NFO_UP25,
+    NFO_BP25,
+    NFO_BC25,
+    NFO_BI25,
+    NFO_LL25,
+    NFO_CB01,
+    NFO_FAN1,
+    NFO_TBT,
+    NFO_TBTE,
+    NFO_VG11_FM01,
+    NFO_VG11_FM02,
+    NFO_DLOG,
+    NFO_LOGGING,
+};
+
+struct nfo {
+    enum nfo_id id;
+    uint16_t revision;
+    uint16_t variant;
+    uint16_t address;
+    uint32_t serial;
+    uint32_t version;
+    uint32_t timestamp;
+};
+
+extern struct nfo *
+nfo_new(enum nfo_id id);
+
+#endif /* _HOST_INC_LIB_NFO_H */
@@ -0,0 +1,12 @@
+/**************************************************************************************************
+ *
+ * \file ntc.h
+ *
+ * \brief Host stand-in for the fw_lib NTC conversion header, not used in host builds
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_NTC_H
+#define _HOST_INC_LIB_NTC_H
+
+#endif /* _HOST_INC_LIB_NTC_H */
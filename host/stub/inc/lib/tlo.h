@@ -0,0 +1,18 @@
+/**************************************************************************************************
+ *
+ * \file tlo.h
+ *
+ * \brief Host stand-in for the fw_lib top-level object header
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_LIB_TLO_H
+#define _HOST_INC_LIB_TLO_H
+
+struct tlo;
+
+/** Implemented by the application                                                                */
+extern const struct tlo *
+tlo_new(void);
+
+#endif /* _HOST_INC_LIB_TLO_H */
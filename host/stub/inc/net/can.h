@@ -0,0 +1,25 @@
+/**************************************************************************************************
+ *
+ * \file can.h
+ *
+ * \brief Host stand-in for the fw_lib CAN network interface
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_NET_CAN_H
+#define _HOST_INC_NET_CAN_H
+
+#include <stdint.h>
+
+struct net;
+
+struct can_f {
+    uint32_t id;
+    uint16_t length;
+    uint16_t data[8];
+};
+
+extern int can_write(const struct net *net, const struct can_f *f);
+extern int can_read(const struct net *net, struct can_f *f);
+
+#endif /* _HOST_INC_NET_CAN_H */
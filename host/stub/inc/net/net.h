@@ -0,0 +1,14 @@
+/**************************************************************************************************
+ *
+ * \file net.h
+ *
+ * \brief Host stand-in for the fw_lib network interface
+ *
+ *************************************************************************************************/
+
+#ifndef _HOST_INC_NET_NET_H
+#define _HOST_INC_NET_NET_H
+
+struct net;
+
+#endif /* _HOST_INC_NET_NET_H */
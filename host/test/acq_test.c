@@ -0,0 +1,147 @@
+/**************************************************************************************************
+ *
+ * \file acq_test.c
+ *
+ * \brief Ping-pong acquisition buffer with both producers: the per-sample ADC interrupt and the
+ * DMA, which fills a half on its own and only interrupts at the half boundary. Checks the
+ * hand-over to the PHY job, the filtered values and what happens when the job falls behind.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/acq.h"
+#include "app/task_evt.h"
+
+#include "check.h"
+
+#include <math.h>
+
+/** Raw result of channel ch in a block tagged with n                                           */
+#define RAW(n, ch)  ((uint16_t) (100U * (n) + 10U * (ch)))
+
+static float
+volts(uint16_t raw)
+{
+    return (float) raw * (ACQ_ADC_VREF / (float) ACQ_ADC_RESOLUTION);
+}
+
+/** ADC interrupt: one row per end of conversion                                                */
+static void
+isr_block(struct acq *acq, uint16_t n)
+{
+    uint16_t i, ch;
+    for (i = 0U; i < ACQ_BLOCK; i++) {
+        uint16_t *row = acq_row(acq);
+        for (ch = 0U; ch < ACQ_CH_N; ch++) {
+            row[ch] = RAW(n, ch);
+        }
+        acq_push(acq);
+    }
+}
+
+/** DMA: a whole half written from the destination set at the last boundary, then the
+ * interrupt, which returns the next destination                                                */
+static uint16_t *
+dma_block(struct acq *acq, uint16_t *dst, uint16_t n)
+{
+    uint16_t i, ch;
+    for (i = 0U; i < ACQ_BLOCK; i++) {
+        for (ch = 0U; ch < ACQ_CH_N; ch++) {
+            dst[i * ACQ_CH_N + ch] = RAW(n, ch);
+        }
+    }
+    return acq_commit(acq);
+}
+
+/** A block is handed over once full, and the PHY job is woken up                               */
+static void
+test_isr_producer(void)
+{
+    struct task_evt *evt = task_evt_new();
+    struct acq *acq = acq_new();
+    acq_notify(acq, evt);
+
+    float v;
+    CHECK(acq_get(acq, ACQ_BUTTON0, &v) < 0);
+    CHECK(acq_run(acq) == 0);
+
+    isr_block(acq, 1U);
+    CHECK(task_evt_take(evt, TASK_EVT_ACQ) != 0U);
+    CHECK(acq->fill == 1U);
+    CHECK(acq_run(acq) == 1);
+    CHECK(acq_run(acq) == 0);
+
+    uint16_t ch;
+    for (ch = 0U; ch < ACQ_CH_N; ch++) {
+        CHECK(acq_get(acq, (enum acq_ch) ch, &v) == 0);
+        CHECK(fabsf(v - volts(RAW(1U, ch))) < 1e-4f);
+    }
+    CHECK(acq->overrun == 0U);
+}
+
+/** Halves filled by DMA alternate, and every block goes through the filter once                */
+static void
+test_dma_producer(void)
+{
+    struct task_evt *evt = task_evt_new();
+    struct acq *acq = acq_new();
+    acq_notify(acq, evt);
+    acq->dma = true;
+
+    uint16_t *dst = acq->block[0].raw[0];
+    float expect = 0.0f;
+    uint16_t n;
+    for (n = 1U; n <= 8U; n++) {
+        uint16_t *next = dma_block(acq, dst, n);
+        CHECK(next != dst);
+        CHECK(next == acq->block[n & 1U].raw[0]);
+        dst = next;
+
+        CHECK(task_evt_take(evt, TASK_EVT_ACQ) != 0U);
+        CHECK(acq_run(acq) == 1);
+
+        float mean = (float) RAW(n, ACQ_BUTTON2);
+        expect = (n == 1U) ? mean : expect + ACQ_FILTER_ALPHA * (mean - expect);
+    }
+
+    float v;
+    CHECK(acq_get(acq, ACQ_BUTTON2, &v) == 0);
+    CHECK(fabsf(v - expect * (ACQ_ADC_VREF / (float) ACQ_ADC_RESOLUTION)) < 1e-4f);
+    CHECK(acq->blocks == 8U);
+    CHECK(acq->overrun == 0U);
+}
+
+/** A job that falls behind loses the oldest block, the newest one is kept                      */
+static void
+test_overrun(void)
+{
+    struct acq *acq = acq_new();
+
+    uint16_t *dst = acq->block[0].raw[0];
+    dst = dma_block(acq, dst, 1U);
+    CHECK(acq->overrun == 0U);
+
+    /* Block 1 was not processed when block 2 was done, the DMA is writing over it now */
+    dst = dma_block(acq, dst, 2U);
+    CHECK(acq->overrun == 1U);
+    CHECK(dst == acq->block[0].raw[0]);
+    CHECK(acq->ready == (1U << 1U));
+
+    CHECK(acq_run(acq) == 1);
+    CHECK(acq_run(acq) == 0);
+
+    float v;
+    CHECK(acq_get(acq, ACQ_BUTTON1, &v) == 0);
+    CHECK(fabsf(v - volts(RAW(2U, ACQ_BUTTON1))) < 1e-4f);
+}
+
+int
+main(void)
+{
+    test_isr_producer();
+    test_dma_producer();
+    test_overrun();
+
+    return CHECK_RESULT();
+}
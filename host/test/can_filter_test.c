@@ -0,0 +1,229 @@
+/**************************************************************************************************
+ *
+ * \file can_filter_test.c
+ *
+ * \brief CAN filter manager against the simulated CAN controller. Checks that the application
+ * objects never touch fw_lib's message objects and that only device type broadcasts are taken
+ * away from them, and that fw_lib's catch-all object is narrowed to the module and the devices
+ * present outside the sniffer states.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/can_filter.h"
+#include "app/can_rx.h"
+#include "app/dev_ctl.h"
+#include "app/tlo.h"
+#include "app/display/state_machine.h"
+
+#include "hapi_sim.h"
+#include "check.h"
+
+#include <string.h>
+
+static struct tlo tlo;
+
+/** fw_lib's init() with CAN mask 0: one catch-all receive object, here at object first         */
+static void
+fw_lib_init(uint16_t first)
+{
+    hapi_sim_reset();
+    hapi_sim_can_setup(first, 0UL, 0UL);
+}
+
+static struct can_f
+frame(uint32_t id)
+{
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = id;
+    f.length = 8U;
+    return f;
+}
+
+/** Broadcasts go to the ring, every other frame to fw_lib's object                             */
+static void
+test_broadcasts_only(void)
+{
+    fw_lib_init(17U);
+
+    struct can_filter *can_filter = can_filter_new(&tlo);
+    CHECK(can_filter != NULL);
+    CHECK(can_filter->n == CAN_FILTER_OBJS);
+    CHECK(can_filter->fw_rx == (1UL << 16));
+
+    struct can_rx *can_rx = can_rx_new();
+    CHECK(hapi_can_rx_enable(can_rx) == 0);
+
+    struct can_f f = frame(0x03220000UL | CAN_FILTER_ID_DEV_TYPE);
+    CHECK(hapi_sim_can_receive(&f) == 1U);
+    CHECK(can_rx_level(can_rx) == 1U);
+
+    /* Database traffic, own and remote devices */
+    f = frame(0x03220010UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+    f = frame(0x01100001UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+    CHECK(can_rx_level(can_rx) == 1U);
+
+    struct can_rx_frame out;
+    CHECK(can_rx_pop(can_rx, &out));
+    CHECK(out.f.id == (0x03220000UL | CAN_FILTER_ID_DEV_TYPE));
+}
+
+/** Objects above the reserved range are left as fw_lib set them up                             */
+static void
+test_fw_lib_objects_untouched(void)
+{
+    fw_lib_init(3U);
+    hapi_sim_can_setup(20U, 0x00010000UL, 0x00FF0000UL);
+
+    struct hapi_sim_can_obj before[HAPI_CAN_OBJECTS];
+    uint16_t i;
+    for (i = 0U; i < HAPI_CAN_OBJECTS; i++) {
+        before[i] = *hapi_sim_can_obj(i + 1U);
+    }
+
+    struct can_filter *can_filter = can_filter_new(&tlo);
+    CHECK(can_filter != NULL);
+    CHECK(can_filter->n == 2U);
+    CHECK(can_filter->fw_rx == (1UL << 2));
+
+    for (i = 2U; i < HAPI_CAN_OBJECTS; i++) {
+        CHECK(memcmp(&before[i], hapi_sim_can_obj(i + 1U), sizeof(before[i])) == 0);
+    }
+}
+
+/** fw_lib starting at object 1 leaves nothing to reserve, broadcasts stay with fw_lib          */
+static void
+test_nothing_free(void)
+{
+    fw_lib_init(1U);
+
+    struct can_filter *can_filter = can_filter_new(&tlo);
+    CHECK(can_filter != NULL);
+    CHECK(can_filter->n == 0U);
+
+    struct can_f f = frame(0x03220000UL | CAN_FILTER_ID_DEV_TYPE);
+    CHECK(hapi_sim_can_receive(&f) == 1U);
+    CHECK(hapi_can_objects() == 0x00000001UL);
+}
+
+/** A burst is spread over the FIFO while the interrupt is held off, the last object overwrites */
+static void
+test_fifo_burst(void)
+{
+    fw_lib_init(17U);
+
+    struct can_filter *can_filter = can_filter_new(&tlo);
+    CHECK(can_filter != NULL);
+
+    /* Receive interrupt not enabled yet: frames wait in the objects */
+    uint16_t i;
+    for (i = 0U; i < CAN_FILTER_OBJS + 1U; i++) {
+        struct can_f f = frame(((uint32_t) i << 24) | 0x00220000UL | CAN_FILTER_ID_DEV_TYPE);
+        CHECK(hapi_sim_can_receive(&f) == ((i < CAN_FILTER_OBJS) ? i + 1U : CAN_FILTER_OBJS));
+    }
+    CHECK(hapi_sim_can_obj(CAN_FILTER_OBJS)->msglst);
+
+    struct can_rx *can_rx = can_rx_new();
+    CHECK(hapi_can_rx_enable(can_rx) == 0);
+    CHECK(can_rx_level(can_rx) == CAN_FILTER_OBJS);
+}
+
+/** fw_lib's object is narrowed to the module and the devices present outside the sniffer states */
+static void
+test_narrow(void)
+{
+    static struct state_machine state_machine;
+    static struct nfo mod, boot;
+    static struct tlo tlo;
+
+    fw_lib_init(17U);
+    hapi_sim_can_setup(20U, 0x00010000UL, 0x00FF0000UL);
+
+    memset(&tlo, 0u, sizeof(tlo));
+    state_machine.currentState = state_sniffer_stack;
+    mod.id = NFO_FAN1;
+    mod.address = 1U;
+    boot.id = NFO_BOOT;
+    boot.address = 1U;
+    tlo.mod = &mod;
+    tlo.boot = &boot;
+    tlo.state_machine = &state_machine;
+    tlo.dev_ctl = dev_ctl_new(&tlo);
+
+    struct can_filter *can_filter = can_filter_new(&tlo);
+    CHECK(can_filter != NULL);
+    CHECK(can_filter->fw_rx == (1UL << 16));
+
+    /* A BP25 at stack 3 registers while the devices are listed: everything is accepted */
+    struct can_f f = frame(0x03050000UL | CAN_FILTER_ID_DEV_TYPE);
+    CHECK(dev_ctl_update_devices(&tlo, &f));
+    CHECK(can_filter_update(can_filter, &tlo) == 0);
+    f = frame(0x04050010UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+
+    /* Main view: the module, its boot loader and the BP25 only */
+    state_machine.currentState = state_main;
+    CHECK(can_filter_update(can_filter, &tlo) == 1);
+    CHECK(can_filter->updates == 1U);
+    CHECK(hapi_sim_can_obj(20U)->mask == 0x00FF0000UL);
+
+    f = frame(0x03050010UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+    f = frame(0x010A0010UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+    f = frame(0x01010010UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+    f = frame(0x04050010UL);
+    CHECK(hapi_sim_can_receive(&f) == 0U);
+    f = frame(0x03220010UL);
+    CHECK(hapi_sim_can_receive(&f) == 0U);
+
+    /* Broadcasts still reach the application objects */
+    f = frame(0x09030000UL | CAN_FILTER_ID_DEV_TYPE);
+    CHECK(hapi_sim_can_receive(&f) == 1U);
+
+    /* Nothing changed: the objects are not reprogrammed */
+    CHECK(can_filter_update(can_filter, &tlo) == 0);
+    CHECK(can_filter->updates == 1U);
+
+    /* The BP25 leaves: its frames are dropped too */
+    dev_ctl_remove(tlo.dev_ctl, dev_ctl_find(tlo.dev_ctl, NFO_BP25, 3U));
+    CHECK(can_filter_update(can_filter, &tlo) == 1);
+    f = frame(0x03050010UL);
+    CHECK(hapi_sim_can_receive(&f) == 0U);
+    f = frame(0x010A0010UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+
+    /* Back to the device list: everything is accepted again */
+    state_machine.currentState = state_sniffer_version;
+    CHECK(can_filter_update(can_filter, &tlo) == 1);
+    f = frame(0x04050010UL);
+    CHECK(hapi_sim_can_receive(&f) == 17U);
+}
+
+/** Reservation rule on its own                                                                  */
+static void
+test_reserve(void)
+{
+    CHECK(can_filter_reserve(0UL) == CAN_FILTER_OBJS);
+    CHECK(can_filter_reserve(0x00000001UL) == 0U);
+    CHECK(can_filter_reserve(0x00000004UL) == 2U);
+    CHECK(can_filter_reserve(0xFFFF0000UL) == CAN_FILTER_OBJS);
+}
+
+int
+main(void)
+{
+    test_broadcasts_only();
+    test_fw_lib_objects_untouched();
+    test_nothing_free();
+    test_fifo_burst();
+    test_narrow();
+    test_reserve();
+
+    return CHECK_RESULT();
+}
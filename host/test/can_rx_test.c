@@ -0,0 +1,171 @@
+/**************************************************************************************************
+ *
+ * \file can_rx_test.c
+ *
+ * \brief CAN receive ring buffer, fed by the receive interrupt model of the simulated CAN
+ * controller. Its high-water mark and drop count go out on the diagnostic message.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/can_filter.h"
+#include "app/can_rx.h"
+#include "app/task_evt.h"
+#include "app/task_prof.h"
+#include "app/tlo.h"
+
+#include "inc/lib/nfo.h"
+
+#include "hapi_sim.h"
+#include "net_sim.h"
+#include "check.h"
+
+#include <string.h>
+
+static struct tlo tlo;
+
+static struct can_f
+broadcast(uint16_t n)
+{
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = ((uint32_t) (n & 0xFFU) << 24) | 0x00220000UL | CAN_FILTER_ID_DEV_TYPE;
+    f.length = 8U;
+    f.data[0] = n & 0xFFU;
+    return f;
+}
+
+/** Frames come out in order with their timestamp, and raise TASK_EVT_CAN_RX                    */
+static void
+test_order(void)
+{
+    struct task_evt *evt = task_evt_new();
+    struct can_rx *can_rx = can_rx_new();
+    can_rx_notify(can_rx, evt);
+
+    uint16_t i;
+    for (i = 0U; i < 10U; i++) {
+        struct can_f f = broadcast(i);
+        CHECK(can_rx_push(can_rx, &f, 100UL + i));
+    }
+    CHECK(task_evt_take(evt, TASK_EVT_CAN_RX) == TASK_EVT_CAN_RX);
+    CHECK(can_rx_level(can_rx) == 10U);
+
+    struct can_rx_frame out;
+    for (i = 0U; i < 10U; i++) {
+        CHECK(can_rx_pop(can_rx, &out));
+        CHECK(out.f.data[0] == i);
+        CHECK(out.timestamp == 100UL + i);
+    }
+    CHECK(!can_rx_pop(can_rx, &out));
+    CHECK(can_rx->hwm == 10U);
+}
+
+/** A full ring drops and counts, indices wrap around the 16-bit range                          */
+static void
+test_overflow_wrap(void)
+{
+    struct can_rx *can_rx = can_rx_new();
+    struct can_rx_frame out;
+    struct can_f f;
+
+    uint16_t i;
+    for (i = 0U; i < CAN_RX_SIZE + 3U; i++) {
+        f = broadcast(i);
+        (void) can_rx_push(can_rx, &f, 0UL);
+    }
+    CHECK(can_rx_level(can_rx) == CAN_RX_SIZE);
+    CHECK(can_rx->overflow == 3UL);
+
+    while (can_rx_pop(can_rx, &out)) {
+    }
+
+    uint32_t n;
+    bool ok = true;
+    for (n = 0UL; n < 70000UL; n++) {
+        f = broadcast((uint16_t) n);
+        ok &= can_rx_push(can_rx, &f, n);
+        ok &= can_rx_pop(can_rx, &out) && out.timestamp == n;
+    }
+    CHECK(ok);
+    CHECK(can_rx_level(can_rx) == 0U);
+}
+
+/** Frames received while fw_lib holds the controller wait in the objects, none is lost         */
+static void
+test_lock(void)
+{
+    hapi_sim_reset();
+    hapi_sim_can_setup(17U, 0UL, 0UL);
+
+    CHECK(can_filter_new(&tlo) != NULL);
+    struct can_rx *can_rx = can_rx_new();
+    CHECK(hapi_can_rx_enable(can_rx) == 0);
+
+    hapi_can_lock(true);
+    uint16_t i;
+    for (i = 0U; i < CAN_FILTER_OBJS; i++) {
+        struct can_f f = broadcast(i);
+        (void) hapi_sim_can_receive(&f);
+    }
+    CHECK(can_rx_level(can_rx) == 0U);
+    hapi_can_lock(false);
+
+    CHECK(can_rx_level(can_rx) == CAN_FILTER_OBJS);
+
+    struct can_rx_frame out;
+    for (i = 0U; i < CAN_FILTER_OBJS; i++) {
+        CHECK(can_rx_pop(can_rx, &out) && out.f.data[0] == i);
+    }
+}
+
+/** The diagnostic job sends the ring frame after the CPU load frame                             */
+static void
+test_publish(void)
+{
+    static struct nfo mod;
+    static struct tlo diag;
+
+    net_sim_reset();
+    mod.id = NFO_FAN1;
+    mod.address = 2U;
+    diag.mod = &mod;
+    diag.can = (const struct net *) &mod;
+    diag.can_rx = can_rx_new();
+
+    uint16_t i;
+    for (i = 0U; i < CAN_RX_SIZE + 5U; i++) {
+        struct can_f f = broadcast(i);
+        (void) can_rx_push(diag.can_rx, &f, 0UL);
+    }
+
+    struct task_prof *task_prof = task_prof_new();
+    CHECK(task_prof_register(task_prof, TASK_PROF_CAN, "CAN", 1000.0f) == 0);
+
+    /* CAN job frame, load frame, ring frame, then the CAN job again */
+    const struct can_f *f = net_sim_tx_last();
+    CHECK(task_prof_publish(task_prof, &diag) == 0);
+    CHECK(f->data[0] == TASK_PROF_CAN);
+    CHECK(task_prof_publish(task_prof, &diag) == 0);
+    CHECK(f->data[0] == TASK_PROF_MUX_LOAD);
+    CHECK(task_prof_publish(task_prof, &diag) == 0);
+    CHECK(f->id == (0x020A0000UL | TASK_PROF_MSG_ID));
+    CHECK(f->data[0] == TASK_PROF_MUX_CAN_RX);
+    CHECK(((uint16_t) f->data[1] << 8 | f->data[2]) == CAN_RX_SIZE);
+    CHECK(f->data[6] == 5U);
+    CHECK(f->data[7] == CAN_RX_SIZE);
+    CHECK(task_prof_publish(task_prof, &diag) == 0);
+    CHECK(f->data[0] == TASK_PROF_CAN);
+}
+
+int
+main(void)
+{
+    test_order();
+    test_overflow_wrap();
+    test_lock();
+    test_publish();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,123 @@
+/**************************************************************************************************
+ *
+ * \file dev_ctl_alive_test.c
+ *
+ * \brief Device liveness on the simulated timestamp counter. The registry clock follows the
+ * hardware counter whatever the control job period, and a device is absent exactly
+ * DEV_CTL_ALIVE_TIMEOUT_MS after it was last heard from.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/dev_ctl.h"
+#include "app/display/state_machine.h"
+
+#include "hapi_sim.h"
+#include "check.h"
+
+#include <string.h>
+
+#define TICKS_MS    (HAPI_TIMESTAMP_FREQ / 1000UL)
+
+static struct state_machine state_machine;
+static struct tlo tlo;
+
+static void
+setup(uint32_t start)
+{
+    hapi_sim_reset();
+    hapi_sim_advance(start);
+    memset(&state_machine, 0u, sizeof(state_machine));
+    state_machine.currentState = state_sniffer_stack;
+    memset(&tlo, 0u, sizeof(tlo));
+    tlo.state_machine = &state_machine;
+    tlo.dev_ctl = dev_ctl_new(&tlo);
+}
+
+static void
+broadcast(uint8_t stack, uint32_t serial_number)
+{
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = ((uint32_t) stack << 24) | ((uint32_t) NFO_BP25 << 16) | 0x8000UL;
+    f.length = 8U;
+    f.data[4] = (serial_number >> 24) & 0xFFU;
+    f.data[5] = (serial_number >> 16) & 0xFFU;
+    f.data[6] = (serial_number >>  8) & 0xFFU;
+    f.data[7] = (serial_number >>  0) & 0xFFU;
+    (void) dev_ctl_update_devices(&tlo, &f);
+}
+
+/** Runs the control job every period ticks until the registry clock reaches ms                 */
+static void
+run_until(uint32_t ms, uint32_t period)
+{
+    while (tlo.dev_ctl->timestamp < ms) {
+        hapi_sim_advance(period);
+        dev_ctl_update_timestamp(tlo.dev_ctl);
+    }
+}
+
+/** Control job period that does not divide a millisecond: the clock neither drifts nor doubles */
+static void
+test_clock(void)
+{
+    setup(0xFFFFF000UL);   /* Counter wraps during the test */
+
+    uint32_t n;
+    for (n = 0U; n < 10000U; n++) {
+        hapi_sim_advance(TICKS_MS + TICKS_MS / 3U);
+        dev_ctl_update_timestamp(tlo.dev_ctl);
+    }
+    CHECK(tlo.dev_ctl->timestamp == (10000UL * (TICKS_MS + TICKS_MS / 3U)) / TICKS_MS);
+}
+
+/** Device is absent exactly at its deadline                                                     */
+static void
+test_timeout(void)
+{
+    setup(0U);
+
+    broadcast(1U, 0x00000001UL);
+    int i = dev_ctl_find(tlo.dev_ctl, NFO_BP25, 1U);
+    CHECK(i >= 0);
+
+    run_until(DEV_CTL_ALIVE_TIMEOUT_MS - 1UL, TICKS_MS);
+    CHECK(i >= 0 && tlo.dev_ctl->can_dev[i].present);
+    run_until(DEV_CTL_ALIVE_TIMEOUT_MS, TICKS_MS);
+    CHECK(i >= 0 && !tlo.dev_ctl->can_dev[i].present);
+}
+
+/** Broadcasts keep the device present, a long stall of the control job still expires it         */
+static void
+test_refresh_and_stall(void)
+{
+    setup(0U);
+
+    broadcast(2U, 0x00000002UL);
+    int i = dev_ctl_find(tlo.dev_ctl, NFO_BP25, 2U);
+    CHECK(i >= 0);
+
+    uint32_t t;
+    for (t = 1000UL; t <= 10000UL; t += 1000UL) {
+        run_until(t, 5UL * TICKS_MS);
+        broadcast(2U, 0x00000002UL);
+    }
+    CHECK(i >= 0 && tlo.dev_ctl->can_dev[i].present);
+
+    hapi_sim_advance(20000UL * TICKS_MS);
+    dev_ctl_update_timestamp(tlo.dev_ctl);
+    CHECK(tlo.dev_ctl->timestamp >= 30000UL);
+    CHECK(i >= 0 && !tlo.dev_ctl->can_dev[i].present);
+}
+
+int
+main(void)
+{
+    test_clock();
+    test_timeout();
+    test_refresh_and_stall();
+
+    return CHECK_RESULT();
+}
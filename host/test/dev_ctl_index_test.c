@@ -0,0 +1,144 @@
+/**************************************************************************************************
+ *
+ * \file dev_ctl_index_test.c
+ *
+ * \brief Device registry hash index. Checks lookups by serial number and by (id, stack) across
+ * registration, stack changes and removal, and that tombstones left by moves are reclaimed.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/dev_ctl.h"
+#include "app/display/state_machine.h"
+
+#include "hapi_sim.h"
+#include "check.h"
+
+#include <string.h>
+
+static struct state_machine state_machine;
+static struct tlo tlo;
+
+static void
+setup(void)
+{
+    hapi_sim_reset();
+    memset(&state_machine, 0u, sizeof(state_machine));
+    state_machine.currentState = state_sniffer_stack;
+    memset(&tlo, 0u, sizeof(tlo));
+    tlo.state_machine = &state_machine;
+    tlo.dev_ctl = dev_ctl_new(&tlo);
+}
+
+/** Device type broadcast of one device                                                          */
+static bool
+broadcast(enum nfo_id id, uint8_t stack, uint32_t serial_number)
+{
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = ((uint32_t) stack << 24) | ((uint32_t) id << 16) | 0x8000UL;
+    f.length = 8U;
+    f.data[4] = (serial_number >> 24) & 0xFFU;
+    f.data[5] = (serial_number >> 16) & 0xFFU;
+    f.data[6] = (serial_number >>  8) & 0xFFU;
+    f.data[7] = (serial_number >>  0) & 0xFFU;
+    return dev_ctl_update_devices(&tlo, &f);
+}
+
+/** Deleted buckets left in one index table                                                      */
+static uint16_t
+tombstones(const uint8_t *index)
+{
+    uint16_t n = 0U;
+    uint16_t b;
+    for (b = 0U; b < DEV_CTL_INDEX_SIZE; b++) {
+        if (index[b] == 0xFFU) {
+            n++;
+        }
+    }
+    return n;
+}
+
+/** Every registered device is found by (id, stack)                                             */
+static void
+test_register(void)
+{
+    setup();
+
+    uint16_t i;
+    for (i = 0U; i < N_DEVICES; i++) {
+        CHECK(broadcast(NFO_BP25, (uint8_t) i, 0x10000000UL + i));
+    }
+
+    for (i = 0U; i < N_DEVICES; i++) {
+        int j = dev_ctl_find(tlo.dev_ctl, NFO_BP25, (uint8_t) i);
+        CHECK(j >= 0);
+        CHECK(j >= 0 && tlo.dev_ctl->can_dev[j].serial_number == 0x10000000UL + i);
+        CHECK(!tlo.dev_ctl->can_dev[j].duplicated_stack);
+    }
+    CHECK(dev_ctl_find(tlo.dev_ctl, NFO_VG11_FM01, 0U) < 0);
+}
+
+/** A device moving stack over and over keeps one live index entry and bounded tombstones        */
+static void
+test_move(void)
+{
+    setup();
+
+    CHECK(broadcast(NFO_BP25, 1U, 0xCAFE0001UL));
+    CHECK(broadcast(NFO_VG11_FM01, 2U, 0xCAFE0002UL));
+
+    uint16_t n;
+    for (n = 0U; n < 1000U; n++) {
+        uint8_t stack = (uint8_t) (3U + (n % 200U));
+        CHECK(broadcast(NFO_BP25, stack, 0xCAFE0001UL));
+        CHECK(tombstones(tlo.dev_ctl->index_dev) <= DEV_CTL_INDEX_SIZE / 4U);
+    }
+
+    uint8_t last = (uint8_t) (3U + (999U % 200U));
+    CHECK(dev_ctl_find(tlo.dev_ctl, NFO_BP25, last) >= 0);
+    CHECK(dev_ctl_find(tlo.dev_ctl, NFO_BP25, 1U) < 0);
+    CHECK(dev_ctl_find(tlo.dev_ctl, NFO_VG11_FM01, 2U) >= 0);
+
+    /* The moved device is still one slot, found again by its serial number */
+    CHECK(broadcast(NFO_BP25, last, 0xCAFE0001UL));
+    int i = dev_ctl_find(tlo.dev_ctl, NFO_BP25, last);
+    int count = 0;
+    int j;
+    for (j = 0; j < N_DEVICES; j++) {
+        if (tlo.dev_ctl->can_dev[j].serial_number == 0xCAFE0001UL) {
+            count++;
+        }
+    }
+    CHECK(count == 1);
+    CHECK(i >= 0 && !tlo.dev_ctl->can_dev[i].duplicated_stack);
+}
+
+/** Two devices at the same (id, stack) are both flagged, removal keeps the other one findable   */
+static void
+test_duplicate_remove(void)
+{
+    setup();
+
+    CHECK(broadcast(NFO_BP25, 5U, 0x00000001UL));
+    CHECK(broadcast(NFO_BP25, 5U, 0x00000002UL));
+
+    int i = dev_ctl_find(tlo.dev_ctl, NFO_BP25, 5U);
+    CHECK(i >= 0);
+    CHECK(i >= 0 && tlo.dev_ctl->can_dev[i].duplicated_stack);
+
+    dev_ctl_remove(tlo.dev_ctl, i);
+    int j = dev_ctl_find(tlo.dev_ctl, NFO_BP25, 5U);
+    CHECK(j >= 0 && j != i);
+}
+
+int
+main(void)
+{
+    test_register();
+    test_move();
+    test_duplicate_remove();
+
+    return CHECK_RESULT();
+}
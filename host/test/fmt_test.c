@@ -0,0 +1,104 @@
+/**************************************************************************************************
+ *
+ * \file fmt_test.c
+ *
+ * \brief Fixed-point formatter against known strings, and fmt_float() against printf on values
+ * that are not halfway between two display steps.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/fmt.h"
+
+#include "check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FMT_CHECK(expect, call)                                                                 \
+    do {                                                                                        \
+        char buf[FMT_WIDTH_MAX + 8U];                                                           \
+        uint16_t len = (call);                                                                  \
+        CHECK(strcmp(buf, expect) == 0);                                                        \
+        CHECK(len == strlen(expect));                                                           \
+    } while (0)
+
+/** Known strings, including the edges of the number field and of int32_t                       */
+static void
+test_fixed(void)
+{
+    FMT_CHECK("  230.1", fmt_fixed(buf, 7U, 2301L, 1U, NULL));
+    FMT_CHECK(" -230.1V", fmt_fixed(buf, 7U, -2301L, 1U, "V"));
+    FMT_CHECK("   0.05", fmt_fixed(buf, 7U, 5L, 2U, NULL));
+    FMT_CHECK("  -0.05", fmt_fixed(buf, 7U, -5L, 2U, NULL));
+    FMT_CHECK("0", fmt_fixed(buf, 1U, 0L, 0U, NULL));
+    FMT_CHECK("###kW", fmt_fixed(buf, 3U, 1000L, 0U, "kW"));
+    FMT_CHECK("-2147483648", fmt_fixed(buf, 11U, INT32_MIN, 0U, NULL));
+    FMT_CHECK(" 2147.483647", fmt_fixed(buf, FMT_WIDTH_MAX, INT32_MAX, 6U, NULL));
+}
+
+/** Rounding half away from zero, saturated to int32_t                                           */
+static void
+test_scale(void)
+{
+    CHECK(fmt_scale(1.25f, 1U) == 13L);
+    CHECK(fmt_scale(-1.25f, 1U) == -13L);
+    CHECK(fmt_scale(0.004f, 2U) == 0L);
+    CHECK(fmt_scale(1e12f, 0U) == INT32_MAX);
+    CHECK(fmt_scale(-1e12f, 0U) == INT32_MIN);
+}
+
+/** Same text as printf, away from ties where the two rounding rules may differ                 */
+static void
+test_float(void)
+{
+    char buf[FMT_WIDTH_MAX + 8U];
+    char ref[FMT_WIDTH_MAX + 8U];
+    unsigned n;
+
+    srand(1U);
+    for (n = 0U; n < 100000U; n++) {
+        uint16_t decimals = (uint16_t) (rand() % 4);
+        float value = ((float) rand() / (float) RAND_MAX - 0.5f) * 2000.0f;
+
+        float steps = value * ((decimals == 0U) ? 1.0f : (decimals == 1U) ? 10.0f :
+            (decimals == 2U) ? 100.0f : 1000.0f);
+        float frac = steps - (float) (long) steps;
+        if (frac < 0.0f) {
+            frac = -frac;
+        }
+        if (frac > 0.49f && frac < 0.51f) {
+            continue;
+        }
+
+        (void) fmt_float(buf, 9U, value, decimals, NULL);
+        (void) snprintf(ref, sizeof(ref), "%9.*f", (int) decimals, (double) value);
+        if (strcmp(buf, ref) == 0) {
+            continue;
+        }
+
+        /* printf keeps the sign of values that round to zero */
+        char *minus = strchr(ref, '-');
+        if (minus && fmt_scale(value, decimals) == 0L) {
+            *minus = ' ';
+            if (strcmp(buf, ref) == 0) {
+                continue;
+            }
+        }
+
+        printf("%.7g with %u decimals: \"%s\", printf \"%s\"\n", value, decimals, buf, ref);
+        CHECK(0);
+    }
+}
+
+int
+main(void)
+{
+    test_fixed();
+    test_scale();
+    test_float();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,201 @@
+/**************************************************************************************************
+ *
+ * \file ipc_thread_test.c
+ *
+ * \brief Dual-core split run as two threads. The CAN side drains the request queue into the
+ * registry and keeps publishing the snapshot, the user interface side reads the snapshot and
+ * queues setpoint requests for the device as it sees it there. Checks that no torn entry is ever
+ * read and that every queued request is applied once, in order.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/dev_ctl.h"
+#include "app/dev_snap.h"
+#include "app/ipc_queue.h"
+#include "app/display/state_machine.h"
+
+#include "hapi_sim.h"
+#include "check.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+/** Requests the user interface side queues                                                      */
+#define REQUESTS    (20000U)
+
+static struct state_machine state_machine;
+static struct tlo tlo;
+static struct dev_snap *dev_snap;
+static struct ipc_queue *ui_cmd;
+static int dev;
+
+static volatile bool ui_done;
+
+/** CAN side results, read once both threads have been joined                                   */
+static uint32_t applied;
+static uint32_t out_of_order;
+static uint32_t publishes;
+
+/** User interface side results                                                                 */
+static uint32_t reads;
+static uint32_t torn;
+static uint32_t full;
+
+/** Owns the registry: applies requests, changes the mesurables and publishes them              */
+static void *
+can_core(void *arg)
+{
+    struct can_dev *can_dev = &tlo.dev_ctl->can_dev[dev];
+    struct ipc_msg msg;
+    bool last = false;
+
+    for (;;) {
+        /* Queue is only known to be empty for good once the producer has stopped */
+        bool stop = ui_done;
+        IPC_BARRIER();
+
+        bool idle = true;
+        while (ipc_queue_pop(ui_cmd, &msg)) {
+            idle = false;
+            CHECK(dev_ctl_request(tlo.dev_ctl, &msg) == 0);
+            if (can_dev->setpoints[0] != (float) applied) {
+                out_of_order++;
+            }
+            applied++;
+        }
+
+        /* Every mesurable gets the same value, a torn copy shows as a mismatch */
+        uint16_t i;
+        for (i = 0U; i < DEV_CTL_MESURABLES; i++) {
+            can_dev->mesurables[i] = (float) publishes;
+        }
+        dev_snap_publish(dev_snap, tlo.dev_ctl);
+        publishes++;
+
+        if (last) {
+            break;
+        }
+        last = stop;
+
+        if (idle) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/** Queues a request with the device type and stack of the snapshot, as the display view does   */
+static int
+ui_request(uint16_t type, uint16_t arg, float value)
+{
+    struct dev_snap_dev snap;
+
+    if (dev_snap_read(dev_snap, (uint16_t) dev, &snap) < 0 || !snap.present) {
+        return -1;
+    }
+
+    struct ipc_msg msg = {
+        .type = type,
+        .dev = (uint16_t) dev,
+        .id = snap.id,
+        .stack = snap.stack,
+        .arg = arg,
+        .value = value,
+    };
+
+    return ipc_queue_push(ui_cmd, &msg) ? 0 : -1;
+}
+
+/** Reads the snapshot and queues one setpoint per request, retrying when it cannot be queued   */
+static void *
+ui_core(void *arg)
+{
+    uint32_t n = 0U;
+
+    while (n < REQUESTS) {
+        struct dev_snap_dev snap;
+        if (dev_snap_read(dev_snap, (uint16_t) dev, &snap) == 0) {
+            reads++;
+
+            uint16_t i;
+            for (i = 1U; i < snap.n_mesurables; i++) {
+                if (snap.mesurables[i] != snap.mesurables[0]) {
+                    torn++;
+                    break;
+                }
+            }
+        }
+
+        if (ui_request(IPC_MSG_SETPOINT, 0U, (float) n) == 0) {
+            n++;
+        } else {
+            /* Queue full or entry being written, the other side needs the CPU on one-core hosts */
+            full++;
+            sched_yield();
+        }
+    }
+
+    IPC_BARRIER();
+    ui_done = true;
+
+    return NULL;
+}
+
+int
+main(void)
+{
+    hapi_sim_reset();
+    state_machine.currentState = state_sniffer_stack;
+    tlo.state_machine = &state_machine;
+    tlo.dev_ctl = dev_ctl_new(&tlo);
+    dev_snap = dev_snap_new();
+    ui_cmd = ipc_queue_new();
+
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = (3UL << 24) | ((uint32_t) NFO_BP25 << 16) | 0x8000UL;
+    f.length = 8U;
+    f.data[7] = 0x01U;
+    CHECK(dev_ctl_update_devices(&tlo, &f));
+    dev = dev_ctl_find(tlo.dev_ctl, NFO_BP25, 3U);
+    CHECK(dev >= 0);
+
+    /* Nothing to request before the device is in the snapshot */
+    CHECK(ui_request(IPC_MSG_SETPOINT, 0U, 0.0f) < 0);
+    dev_snap_publish(dev_snap, tlo.dev_ctl);
+
+    pthread_t can, ui;
+    CHECK(pthread_create(&can, NULL, can_core, NULL) == 0);
+    CHECK(pthread_create(&ui, NULL, ui_core, NULL) == 0);
+    pthread_join(ui, NULL);
+    pthread_join(can, NULL);
+
+    CHECK(applied == REQUESTS);
+    CHECK(out_of_order == 0U);
+    CHECK(torn == 0U);
+    CHECK(reads > 0U);
+    CHECK(ui_cmd->dropped <= full);
+
+    /* Setpoint past the end of the device, or of the registry entry, is refused */
+    struct can_dev *can_dev = &tlo.dev_ctl->can_dev[dev];
+    struct ipc_msg msg;
+    memset(&msg, 0u, sizeof(msg));
+    msg.type = IPC_MSG_SETPOINT;
+    msg.dev = (uint16_t) dev;
+    msg.id = can_dev->id;
+    msg.stack = can_dev->stack;
+    msg.value = 1.0f;
+    msg.arg = (uint16_t) DEV_setpoints_enum_end(can_dev);
+    CHECK(dev_ctl_request(tlo.dev_ctl, &msg) < 0);
+    msg.arg = sizeof(can_dev->setpoints) / sizeof(can_dev->setpoints[0]);
+    CHECK(dev_ctl_request(tlo.dev_ctl, &msg) < 0);
+
+    printf("%u requests, %u retried, %u snapshot reads, %u publishes\n",
+            (unsigned) applied, (unsigned) full, (unsigned) reads, (unsigned) publishes);
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,262 @@
+/**************************************************************************************************
+ *
+ * \file page_test.c
+ *
+ * \brief Device page renderer with the host atlas (3x5 stand-in font). Glyphs land on the right
+ * pixels at even and odd x, a new device is drawn in full, and afterwards only the cells whose
+ * text changed are touched. On the scheduler model, the screen job binds the custom view of the
+ * device through page_follow() once the state machine is on its main view and sends the page,
+ * bridge temperature included; a value change alone then brings a render that sends only its cell.
+ * The panel decoded by the controller model matches the frame after each. Key input renders the
+ * device page faster than the blocking library pages.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/page.h"
+#include "app/atlas.h"
+#include "app/cell.h"
+#include "app/dev_snap.h"
+#include "app/can_filter.h"
+#include "app/tlo.h"
+#include "app/screen.h"
+#include "app/task_evt.h"
+#include "app/display/state_machine.h"
+
+#include "inc/lib/alert.h"
+
+#include "hapi_sim.h"
+#include "net_sim.h"
+#include "task_sim.h"
+#include "ssd1322_sim.h"
+#include "check.h"
+
+#include <string.h>
+
+#define TICKS_US    (HAPI_TIMESTAMP_FREQ / 1000000UL)
+#define TICKS_MS    (HAPI_TIMESTAMP_FREQ / 1000UL)
+
+/** Gray level of a frame pixel                                                                  */
+static uint16_t
+pixel(const uint8_t *buf, uint16_t x, uint16_t y)
+{
+    uint8_t v = buf[y * SCREEN_ROW_BYTES + x / 2U];
+    return (x & 1U) ? (v & 0x0FU) : (v >> 4);
+}
+
+/** Snapshot with one device in slot 0                                                           */
+static struct dev_snap *
+snap(float value)
+{
+    struct dev_snap *dev_snap = dev_snap_new();
+    struct dev_snap_dev *dev = &dev_snap->dev[0];
+
+    dev->present = true;
+    dev->id = NFO_BP25;
+    dev->stack = 3U;
+    dev->n_mesurables = 2U;
+    dev->mesurables[0] = value;
+    dev->mesurables[1] = 1.5f;
+
+    return dev_snap;
+}
+
+/** Glyph rows are copied at even x and shifted by a nibble at odd x                             */
+static void
+test_glyph(void)
+{
+    static uint8_t buf[SCREEN_BUF_SIZE];
+    const struct atlas_font *font = atlas_font_find("HostFont3x5");
+    CHECK(font != NULL);
+
+    /* '1' is .#. / ##. / .#. / .#. / ###, drawn with its top row at y = 0 */
+    uint16_t x;
+    for (x = 10U; x <= 11U; x++) {
+        memset(buf, 0u, sizeof(buf));
+        CHECK(atlas_text(buf, (int16_t) x, 5, font, "1") == (int16_t) x + 4);
+
+        CHECK(pixel(buf, x, 0U) == 0U);
+        CHECK(pixel(buf, x + 1U, 0U) == 0xFU);
+        CHECK(pixel(buf, x, 1U) == 0xFU);
+        CHECK(pixel(buf, x + 2U, 1U) == 0U);
+        CHECK(pixel(buf, x, 4U) == 0xFU);
+        CHECK(pixel(buf, x + 2U, 4U) == 0xFU);
+        CHECK(pixel(buf, x - 1U, 4U) == 0U);
+        CHECK(pixel(buf, x + 3U, 4U) == 0U);
+        CHECK(pixel(buf, x + 1U, 5U) == 0U);
+    }
+}
+
+/** A new device is drawn in full, then only the cell that changed                               */
+static void
+test_cells(void)
+{
+    struct page *page = page_new();
+    CHECK(page != NULL);
+    CHECK(page->char_w == 4);
+    CHECK(page->line_h == 7);
+
+    struct cell_page *cells = cell_page_new();
+    struct dev_snap *dev_snap = snap(230.0f);
+
+    CHECK(page_draw(page, cells, dev_snap) == -1);
+
+    CHECK(cell_page_select(cells, 0, 0));
+    CHECK(cell_bind(cells, 0U, "V", 0, 16, 32U, 7U) != NULL);
+    CHECK(cell_bind(cells, 1U, "A", 128, 16, 32U, 7U) != NULL);
+    CHECK(cell_page_update(cells, &dev_snap->dev[0]) == 2U);
+
+    CHECK(page_draw(page, cells, dev_snap) == 1);
+    CHECK(page->pages == 1U);
+    CHECK(page->cells == 2U);
+    CHECK(!cells->cell[0].dirty && !cells->cell[1].dirty);
+
+    /* Header: module icon frame in the top left corner */
+    CHECK(pixel(page->buf, 0U, 0U) == 0xFU);
+    CHECK(pixel(page->buf, 7U, 7U) == 0xFU);
+
+    /* "   230.0" and "    1.50" right-aligned, last digit in the eighth character */
+    CHECK(pixel(page->buf, 28U, 18U) == 0xFU);
+    CHECK(pixel(page->buf, 128U + 28U, 18U) == 0xFU);
+
+    static uint8_t before[SCREEN_BUF_SIZE];
+    memcpy(before, page->buf, sizeof(before));
+
+    /* Same display step: nothing to draw */
+    dev_snap->dev[0].mesurables[0] = 230.04f;
+    CHECK(cell_page_update(cells, &dev_snap->dev[0]) == 0U);
+    CHECK(page_draw(page, cells, dev_snap) == 0);
+    CHECK(page->cells == 2U);
+    CHECK(memcmp(before, page->buf, sizeof(before)) == 0);
+
+    /* Only the bytes of the first cell change */
+    dev_snap->dev[0].mesurables[0] = 231.0f;
+    CHECK(cell_page_update(cells, &dev_snap->dev[0]) == 1U);
+    CHECK(page_draw(page, cells, dev_snap) == 0);
+    CHECK(page->cells == 3U);
+
+    uint16_t i;
+    for (i = 0U; i < SCREEN_BUF_SIZE; i++) {
+        uint16_t x = (i % SCREEN_ROW_BYTES) * 2U;
+        uint16_t y = i / SCREEN_ROW_BYTES;
+        if (before[i] != page->buf[i]) {
+            CHECK(x < 32U && y >= 16U && y < 23U);
+        }
+    }
+
+    /* Back to pages drawn by the library, the next device page starts over */
+    cell_page_select(cells, -1, -1);
+    CHECK(page_draw(page, cells, dev_snap) == -1);
+    CHECK(page->dev == -1);
+}
+
+/** Renders over a second of key input, one TASK_EVT_SCREEN per millisecond                     */
+static uint32_t
+key_renders(const struct tlo *tlo)
+{
+    uint32_t renders = tlo->screen->renders;
+
+    uint16_t ms;
+    for (ms = 0U; ms < 1000U; ms++) {
+        task_evt_set(tlo->task_evt, TASK_EVT_SCREEN);
+        task_sim_run(1U * TICKS_MS);
+    }
+
+    return tlo->screen->renders - renders;
+}
+
+/** On the main view of the state machine, the screen job binds the custom view and sends it   */
+static void
+test_state_machine(void)
+{
+    hapi_sim_reset();
+    net_sim_reset();
+    hapi_sim_cost(HAPI_SIM_SCREEN_BYTE, 1U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_SPI_BYTE, 1U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_RENDER, 500U * TICKS_US);
+
+    const struct tlo *tlo = tlo_new();
+    CHECK(tlo != NULL);
+    CHECK(tlo->page != NULL);
+    CHECK(!alert_get(ALERT_SYSTEM));
+
+    /* A BP25 at stack 3 announces itself while the state machine looks for devices */
+    struct can_f f;
+    memset(&f, 0u, sizeof(f));
+    f.id = (3UL << 24) | ((uint32_t) NFO_BP25 << 16) | CAN_FILTER_ID_DEV_TYPE;
+    f.length = 8U;
+    f.data[7] = 1U;
+    CHECK(hapi_sim_can_receive(&f) != 0U);
+
+    task_sim_run(100U * TICKS_MS);
+    CHECK(tlo->dev_ctl->can_dev[0].present);
+    CHECK(tlo->cells->dev == -1);
+    CHECK(tlo->page->pages == 0U);
+
+    /* Main view: custom view cells bound, page drawn and sent in full */
+    tlo->dev_ctl->can_dev[0].mesurables[BP25_temp_bridge] = 45.25;
+    tlo->state_machine->currentState = state_main;
+    task_sim_run(1000U * TICKS_MS);
+
+    CHECK(tlo->cells->dev == 0);
+    CHECK(tlo->cells->n == PAGE_CELLS);
+    uint16_t i;
+    for (i = 0U; i < PAGE_CELLS; i++) {
+        const struct cell *cell = &tlo->cells->cell[i];
+        CHECK(cell->mesurable == (uint16_t) tlo->dev_ctl->can_dev[0].custom_mesurables[i]);
+        CHECK(cell->valid && !cell->dirty);
+    }
+    CHECK(tlo->page->pages == 1U);
+    CHECK(tlo->page->temp == BP25_temp_bridge);
+    CHECK(strcmp(tlo->page->temp_text, "  45.3C") == 0);
+    CHECK(tlo->screen->frames >= 1U);
+    CHECK(hapi_sim_spi()->dma_bytes >= SCREEN_BUF_SIZE);
+
+    /* What the controller got is what was drawn */
+    static uint8_t panel[SCREEN_BUF_SIZE];
+    ssd1322_sim_panel(panel);
+    CHECK(memcmp(panel, tlo->page->buf, sizeof(panel)) == 0);
+
+    /* Nothing changed: renders at the slowest rate, nothing goes out */
+    uint32_t drawn = tlo->page->cells;
+    uint32_t bytes = hapi_sim_spi()->dma_bytes;
+    task_sim_run(1000U * TICKS_MS);
+    CHECK(tlo->page->cells == drawn);
+    CHECK(hapi_sim_spi()->dma_bytes == bytes);
+
+    /* A value moving to another display step brings a render on its own, only its cell is sent */
+    uint32_t renders = tlo->screen->renders;
+    tlo->dev_ctl->can_dev[0].mesurables[tlo->dev_ctl->can_dev[0].custom_mesurables[1]] = 12.0;
+    task_sim_run(100U * TICKS_MS);
+    CHECK(tlo->screen->renders > renders);
+    CHECK(tlo->page->cells == drawn + 1U);
+    CHECK(hapi_sim_spi()->dma_bytes > bytes);
+    CHECK(hapi_sim_spi()->dma_bytes - bytes < SCREEN_BUF_SIZE / 8U);
+    ssd1322_sim_panel(panel);
+    CHECK(memcmp(panel, tlo->page->buf, sizeof(panel)) == 0);
+
+    /* Key input renders the sliced device page at up to 1000 / SCREEN_REFRESH_MIN_MS per second */
+    uint32_t n = key_renders(tlo);
+    CHECK(n > 1000U / SCREEN_REFRESH_LIB_MS + 1U);
+    CHECK(n <= 1000U / SCREEN_REFRESH_MIN_MS + 1U);
+
+    /* Back to the library pages at the next render: cells unbound, the page starts over */
+    tlo->state_machine->currentState = state_sniffer_stack;
+    task_sim_run(SCREEN_REFRESH_MAX_MS * TICKS_MS);
+    CHECK(tlo->cells->dev == -1);
+    CHECK(tlo->page->dev == -1);
+
+    /* Library pages block the slot task while they render, they keep the slower rate */
+    CHECK(key_renders(tlo) <= 1000U / SCREEN_REFRESH_LIB_MS + 1U);
+}
+
+int
+main(void)
+{
+    test_glyph();
+    test_cells();
+    test_state_machine();
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,163 @@
+/**************************************************************************************************
+ *
+ * \file task_test.c
+ *
+ * \brief task.c and tlo.c against the scheduler model. Jobs keep their periods with room to
+ * spare at the expected call costs, a page render long enough to hold the slot task up shows as
+ * deadline misses, key edges bring key sampling up to 1 kHz, and queued device requests go out
+ * in one CAN job.
+ *
+ * \author Jorge Sola
+ *
+ *************************************************************************************************/
+
+#include "app/tlo.h"
+#include "app/can_tx.h"
+#include "app/dev_ctl.h"
+#include "app/task_prof.h"
+#include "app/display/key.h"
+#include "app/user.h"
+
+#include "inc/api/db.h"
+#include "inc/lib/alert.h"
+
+#include "hapi_sim.h"
+#include "net_sim.h"
+#include "task_sim.h"
+#include "check.h"
+
+#define TICKS_US    (HAPI_TIMESTAMP_FREQ / 1000000UL)
+#define TICKS_MS    (HAPI_TIMESTAMP_FREQ / 1000UL)
+
+/** Starts the application on fresh hardware, calls take render_us per page and typical times
+ * for the rest                                                                                 */
+static const struct tlo *
+boot(uint32_t render_us)
+{
+    hapi_sim_reset();
+    net_sim_reset();
+
+    hapi_sim_cost(HAPI_SIM_SCREEN_BYTE, 1U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_SPI_BYTE, 1U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_CAN_READ, 1U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_CAN_WRITE, 2U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_DB_RUN, 5U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_KEY_READ, 2U * TICKS_US);
+    hapi_sim_cost(HAPI_SIM_RENDER, render_us * TICKS_US);
+
+    const struct tlo *tlo = tlo_new();
+    CHECK(tlo != NULL);
+    CHECK(tlo->task != NULL);
+    CHECK(!alert_get(ALERT_SYSTEM));
+
+    return tlo;
+}
+
+/** Every job keeps its period at the expected costs                                            */
+static void
+test_nominal(void)
+{
+    const struct tlo *tlo = boot(100U);
+
+    task_sim_run(2000U * TICKS_MS);
+
+    const char *name[] = { "slot", "blink", "diag" };
+    uint16_t i;
+    for (i = 0U; i < 3U; i++) {
+        const struct task_sim_job *job = task_sim_job(name[i]);
+        CHECK(job != NULL);
+        CHECK(job->runs > 0U);
+        CHECK(job->late == 0U);
+        CHECK(job->dropped == 0U);
+    }
+
+    /* Slot task runs 5000 times per second, starting no later than a render after release */
+    const struct task_sim_job *slot = task_sim_job("slot");
+    CHECK(slot->runs == 2U * (uint32_t) C_TASK_FREQ_SLOT);
+    CHECK(slot->jitter_max <= 100U * TICKS_US);
+
+    /* CAN has its slot every millisecond, without database traffic it never overruns */
+    struct task_prof_stat stat;
+    CHECK(task_prof_get(tlo->task_prof, TASK_PROF_CAN, &stat) != NULL);
+    CHECK(stat.runs >= 999U && stat.runs <= 1001U);
+    CHECK(stat.overruns == 0U);
+
+    /* Our own database and the diagnostics frames go out */
+    CHECK(net_sim_tx_count() > 0U);
+}
+
+/** A render that takes longer than a slot period holds the others up, and that shows           */
+static void
+test_render_overrun(void)
+{
+    (void) boot(3000U);
+
+    task_sim_run(2000U * TICKS_MS);
+
+    const struct task_sim_job *slot = task_sim_job("slot");
+    CHECK(slot != NULL);
+    CHECK(slot->late > 0U);
+    CHECK(slot->dropped > 0U);
+    CHECK(slot->jitter_max >= 2000U * TICKS_US);
+}
+
+/** Keys are sampled every C_TASK_KEY_FALLBACK_MS, and every millisecond after an edge          */
+static void
+test_key_edge(void)
+{
+    const struct tlo *tlo = boot(100U);
+
+    task_sim_run(100U * TICKS_MS);
+    uint32_t idle = tlo->keys->samples;
+    CHECK(idle >= 100U / C_TASK_KEY_FALLBACK_MS - 1U && idle <= 100U / C_TASK_KEY_FALLBACK_MS + 1U);
+
+    hapi_sim_key_edge();
+    task_sim_run(C_TASK_KEY_HOLD_MS * TICKS_MS);
+    uint32_t held = tlo->keys->samples - idle;
+    CHECK(held >= C_TASK_KEY_HOLD_MS - 1U && held <= C_TASK_KEY_HOLD_MS + 1U);
+}
+
+/** Every queued device is transmitted to by one CAN job, and the device databases are left
+ * unsubscribed, also when the user interface subscribed one                                    */
+static void
+test_can_tx_burst(void)
+{
+    const struct tlo *tlo = boot(100U);
+
+    task_sim_run(1U * TICKS_MS);
+
+    uint16_t i;
+    for (i = 0U; i < 8U; i++) {
+        struct can_dev *can_dev = &tlo->dev_ctl->can_dev[i];
+        can_dev->present = true;
+        can_dev->compatible = true;
+        can_dev->id = NFO_BP25;
+        can_dev->stack = (uint8_t) (i + 1U);
+        can_dev->serial_number = 1000UL + i;
+        can_dev->setpoint_changed = true;
+    }
+    db_subscribe((const struct db *) tlo->db_afe, NFO_BP25, 1U, DB_ID_DEV_ADR_M);
+
+    uint32_t tx = net_sim_tx_count();
+    task_sim_run(1U * TICKS_MS);
+
+    CHECK(tlo->can_tx->count == 0U);
+    CHECK(net_sim_tx_count() - tx >= 8U);
+    for (i = 0U; i < 8U; i++) {
+        CHECK(!tlo->dev_ctl->can_dev[i].setpoint_changed);
+    }
+    CHECK(!((const struct db *) tlo->db_afe)->subscribed);
+    CHECK(!((const struct db *) tlo->db_vg11_fm01)->subscribed);
+    CHECK(!((const struct db *) tlo->db_vg11_fm02)->subscribed);
+}
+
+int
+main(void)
+{
+    test_nominal();
+    test_render_overrun();
+    test_key_edge();
+    test_can_tx_burst();
+
+    return CHECK_RESULT();
+}
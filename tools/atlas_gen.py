@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+Screen atlas generator
+
+Reads the icon sources and GFX fonts registered in CMakeLists.txt and emits a C source file with
+all of them converted to the SSD1322 native format: 4 bits per pixel, two pixels per byte with the
+left pixel in the high nibble, rows padded to whole display RAM columns (4 pixels). app/atlas.c
+can then copy bitmap rows straight into the frame buffer without any per-pixel conversion.
+
+Icons are 8-bit grayscale arrays (one byte per pixel) unless their size matches a 4-bit packed
+bitmap. Icon size is taken from NAME=path:WxH, or the icon is assumed to be square.
+
+Fonts are Adafruit GFX font headers (1 bit per pixel). Set pixels become full white.
+
+Usage:
+    atlas_gen.py -o atlas_table.c NONE=icons/icon_none.c ... --font fonts/FreeMono9pt7b.h
+"""
+
+import argparse
+import math
+import os
+import re
+import sys
+
+COL_PIXELS = 4          # Pixels per SSD1322 display RAM column
+FONT_GRAY = 0xF         # Gray level of set font pixels
+
+
+def parse_array(text, name=None):
+    """Returns values of the first (or the named) C array initialiser in text."""
+    pattern = r'\b{}\s*\[\s*\w*\s*\]'.format(re.escape(name)) if name else r'\[\s*\w*\s*\]'
+    match = re.search(pattern + r'[^=]*=\s*\{(.*?)\}\s*;', text, re.S)
+    if not match:
+        raise ValueError('no array {}'.format(name or ''))
+    body = re.sub(r'/\*.*?\*/|//[^\n]*', '', match.group(1), flags=re.S)
+    return [int(value, 0) for value in re.findall(r'0[xX][0-9a-fA-F]+|\d+', body)]
+
+
+def pack(pixels, width, height):
+    """Packs rows of 4-bit pixels, padded to whole display RAM columns."""
+    padded = (width + COL_PIXELS - 1) // COL_PIXELS * COL_PIXELS
+    data = []
+    for y in range(height):
+        row = pixels[y * width:(y + 1) * width] + [0] * (padded - width)
+        for x in range(0, padded, 2):
+            data.append(((row[x] & 0xF) << 4) | (row[x + 1] & 0xF))
+    return data, padded // 2
+
+
+def load_icon(spec):
+    """Returns (width, height, 4-bit pixels) of an icon source."""
+    path, _, size = spec.partition(':')
+    with open(path) as src:
+        values = parse_array(src.read())
+
+    if size:
+        width, height = (int(n) for n in size.lower().split('x'))
+    else:
+        side = math.isqrt(len(values))
+        if side * side != len(values):
+            side = math.isqrt(len(values) * 2)
+        width = height = side
+
+    if len(values) == width * height:
+        pixels = [value >> 4 for value in values]
+    elif len(values) * 2 == width * height:
+        pixels = []
+        for value in values:
+            pixels += [value >> 4, value & 0xF]
+    else:
+        raise ValueError('{}: {} bytes do not match {}x{}'.format(path, len(values), width, height))
+
+    return width, height, pixels
+
+
+def load_font(path):
+    """Returns (name, first, last, y advance, glyphs) of a GFX font header."""
+    with open(path) as src:
+        text = src.read()
+
+    font = re.search(r'GFXfont\s+(\w+)[^=]*=\s*\{(.*?)\}\s*;', text, re.S)
+    if not font:
+        raise ValueError('{}: no GFXfont'.format(path))
+    name = font.group(1)
+    fields = re.sub(r'\([^)]*\)', '', font.group(2)).split(',')
+    first, last, y_advance = (int(field.strip(), 0) for field in fields[2:5])
+
+    bitmap = parse_array(text, name + 'Bitmaps')
+    glyph_text = re.search(r'\b{}Glyphs\s*\[[^=]*=\s*\{{(.*?)\}}\s*;'.format(name), text, re.S)
+    glyph_text = re.sub(r'/\*.*?\*/|//[^\n]*', '', glyph_text.group(1), flags=re.S)
+
+    glyphs = []
+    for entry in re.findall(r'\{([^}]*)\}', glyph_text):
+        offset, width, height, x_advance, x_offset, y_offset = (
+            int(value, 0) for value in entry.split(','))
+        pixels = []
+        for bit in range(width * height):
+            byte = bitmap[offset + bit // 8]
+            pixels.append(FONT_GRAY if byte & (0x80 >> (bit % 8)) else 0)
+        glyphs.append((width, height, x_advance, x_offset, y_offset, pixels))
+
+    return name, first, last, y_advance, glyphs
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate screen atlas')
+    parser.add_argument('-o', '--output', required=True, help='output C file')
+    parser.add_argument('--font', action='append', default=[], help='GFX font header')
+    parser.add_argument('icons', nargs='*', help='NAME=path/to/icon.c[:WxH]')
+    args = parser.parse_args()
+
+    data = []
+
+    def add(width, height, pixels):
+        packed, stride = pack(pixels, width, height)
+        offset = len(data)
+        data.extend(packed)
+        return '{{ {}U, {}U, {}U, {}UL }}'.format(width, height, stride, offset)
+
+    icons = []
+    for icon in args.icons:
+        name, spec = icon.split('=', 1)
+        icons.append((name.upper(), add(*load_icon(spec))))
+
+    fonts = []
+    for path in args.font:
+        name, first, last, y_advance, glyphs = load_font(path)
+        entries = []
+        for width, height, x_advance, x_offset, y_offset, pixels in glyphs:
+            entries.append('{{ {}, {}, {}, {} }}'.format(
+                add(width, height, pixels), x_advance, x_offset, y_offset))
+        fonts.append((name, first, last, y_advance, entries, os.path.basename(path)))
+
+    with open(args.output, 'w') as out:
+        out.write('/* Generated by tools/atlas_gen.py - do not edit */\n\n')
+        out.write('#include "app/atlas.h"\n\n')
+
+        out.write('const uint8_t atlas_data[] = {\n')
+        for index in range(0, len(data), 16):
+            out.write('    {},\n'.format(', '.join(
+                '0x{:02X}U'.format(value) for value in data[index:index + 16])))
+        out.write('};\n\n')
+
+        out.write('const struct atlas_bitmap atlas_icon[ATLAS_ICON_END] = {\n')
+        for name, entry in icons:
+            out.write('    [ATLAS_ICON_{}] = {},\n'.format(name, entry))
+        out.write('};\n\n')
+
+        for name, first, last, y_advance, entries, source in fonts:
+            out.write('static const struct atlas_glyph atlas_glyph_{}[] = {{  /* {} */\n'.format(
+                name, source))
+            for code, entry in enumerate(entries, first):
+                out.write('    {},  /* 0x{:02X} */\n'.format(entry, code))
+            out.write('};\n\n')
+
+        out.write('const struct atlas_font atlas_font[] = {\n')
+        for name, first, last, y_advance, entries, source in fonts:
+            out.write('    {{ "{}", 0x{:02X}U, 0x{:02X}U, {}U, atlas_glyph_{} }},\n'.format(
+                name, first, last, y_advance, name))
+        if not fonts:
+            out.write('    { "", 0U, 0U, 0U, 0 },\n')
+        out.write('};\n\n')
+        out.write('const unsigned atlas_font_size = {}U;\n'.format(len(fonts)))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())